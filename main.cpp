@@ -5,6 +5,43 @@
 #include <cstdlib>
 #include <sstream>
 #include <iomanip>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <new>
+#include <utility>
+#include <cstring>
+#include <cmath>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SWIFTEX_SSE2
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SWIFTEX_AVX2
+#endif
+
+// Fully unrolls short fixed-count loops so their accumulators stay in registers.
+#if defined(__clang__)
+#define SWIFTEX_UNROLL _Pragma("unroll")
+#elif defined(__GNUC__)
+#define SWIFTEX_UNROLL _Pragma("GCC unroll 16")
+#else
+#define SWIFTEX_UNROLL
+#endif
 
 #ifdef _WIN32
 #define CLEAR_CMD "cls"
@@ -23,21 +60,175 @@ const int STATUS_DELIVERED = 5;
 const int STATUS_RETURNED = 6;
 const int STATUS_MISSING = 7;
 const int STATUS_CANCELLED = 8;
+const int STATUS_COUNT = 9;
+
+// Heaviest parcel a manifest row may declare, in kg.
+const double MAX_WEIGHT_KG = 10000.0;
+
+enum RouteSelection 
+{
+    ROUTE_PROMPT,
+    ROUTE_RECOMMENDED,
+    ROUTE_FIXED
+};
+
+// Terminal behaviour of the engine. The interactive menu keeps the
+// defaults; headless runs (--script) turn off clearing, pauses and
+// optionally all engine output.
+struct ConsolePolicy 
+{
+    bool clearScreen;
+    bool pause;
+    bool verbose;
+
+    ConsolePolicy() : clearScreen(true), pause(true), verbose(true) {}
+};
+
+class NullBuffer : public streambuf 
+{
+protected:
+    int overflow(int c) 
+    { 
+        return c; 
+    }
+};
+
+ConsolePolicy console;
+NullBuffer nullBuffer;
+ostream nullStream(&nullBuffer);
+
+ostream& out() 
+{
+    if (console.verbose) 
+        return cout;
+    nullStream.setstate(ios::badbit);
+    return nullStream;
+}
 
 void clearScreen() {
-    system(CLEAR_CMD);
+    if (console.clearScreen) 
+        system(CLEAR_CMD);
 }
 
 void pauseFunc() 
 {
+    if (!console.pause) 
+        return;
     cout << "\nPress Enter to continue...";
     cin.ignore();
     cin.get();
 }
 
-string getCurrentTimestamp() 
+// Source of "now" for the whole simulation, in epoch milliseconds. The
+// real clock follows the wall clock; the virtual clock only moves when
+// advanced, which lets the engine fast-forward between scheduled events.
+// Switching back to real time keeps whatever lead the virtual clock built up.
+class SimulationClock 
+{
+private:
+    bool virtualMode;
+    long long virtualNow;
+    long long offset;
+
+    static long long wallMs() 
+    {
+        return chrono::duration_cast<chrono::milliseconds>(
+            chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+public:
+    SimulationClock() : virtualMode(false), virtualNow(0), offset(0) {}
+
+    long long nowMs() const 
+    {
+        if (virtualMode) 
+            return virtualNow;
+        return wallMs() + offset;
+    }
+
+    bool isVirtual() const 
+    {
+        return virtualMode;
+    }
+
+    void useVirtual() 
+    {
+        if (!virtualMode) 
+            virtualNow = nowMs();
+        virtualMode = true;
+    }
+
+    void useReal() 
+    {
+        if (virtualMode) 
+            offset = virtualNow - wallMs();
+        virtualMode = false;
+    }
+
+    void advanceTo(long long ms) 
+    {
+        if (virtualMode && ms > virtualNow) 
+            virtualNow = ms;
+    }
+
+    void advance(long long ms) 
+    {
+        advanceTo(virtualNow + ms);
+    }
+};
+
+SimulationClock simClock;
+
+const long long LOADING_MS = 5000;
+const long long HOP_INTERVAL_MS = 3000;
+const long long SIGNAL_TIMEOUT_MS = 15000;
+const long long RETRY_DELAY_MS = 5000;
+
+long long nowMs() 
+{
+    return simClock.nowMs();
+}
+
+// Seed for the per-parcel random streams used by the lifecycle.
+unsigned long long simSeed = 0;
+
+inline unsigned long long mix64(unsigned long long x) 
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+inline int lowestBit(unsigned long long word) 
 {
-    time_t now = time(0);
+#if defined(__GNUC__)
+    return __builtin_ctzll(word);
+#else
+    int bit = 0;
+    while (!(word & (1ULL << bit))) 
+        bit++;
+    return bit;
+#endif
+}
+
+inline int highestBit(unsigned long long word) 
+{
+#if defined(__GNUC__)
+    return 63 - __builtin_clzll(word);
+#else
+    int bit = 63;
+    while (!(word & (1ULL << bit))) 
+        bit--;
+    return bit;
+#endif
+}
+
+string formatClock(long long ms) 
+{
+    time_t now = (time_t)(ms / 1000);
     tm *ltm = localtime(&now);
     stringstream ss;
     ss << setfill('0') << setw(2) << ltm->tm_hour << ":" 
@@ -111,933 +302,4338 @@ public:
     { 
         return count == 0; 
     }
-};
 
-class MapGraph;
+    void clear() 
+    {
+        count = 0;
+    }
 
-struct HistoryEvent 
-{
-    string description;
-    string time;
-    string location;
-    HistoryEvent* next;
-    HistoryEvent(string d, string t, string l) : description(d), time(t), location(l), next(nullptr) {}
+    bool equals(const IntArrayList& other) const 
+    {
+        if (count != other.count) 
+            return false;
+        for(int i=0; i<count; i++) 
+            if (data[i] != other.data[i]) 
+                return false;
+        return true;
+    }
 };
 
-class TrackingHistory 
+// City sequence of one route. Ids are kept in 16 bits and the first
+// INLINE_HOPS of them live inside the object, so a typical route is a
+// single 32-byte value with no heap block; longer ones spill to the heap.
+// Moving a route hands its heap block over instead of copying it.
+class Route 
 {
+public:
+    static const int INLINE_HOPS = 12;
+    static const int MAX_CITIES = 65536;
+
 private:
-    HistoryEvent* head;
-    HistoryEvent* tail;
+    int count;
+    int capacity;
+    union 
+    {
+        unsigned short local[INLINE_HOPS];
+        unsigned short* heap;
+    };
 
-public:
-    TrackingHistory() : head(nullptr), tail(nullptr) {}
-    
-    void addEvent(string desc, string loc) 
+    unsigned short* cities() 
     {
-        HistoryEvent* newEvent = new HistoryEvent(desc, getCurrentTimestamp(), loc);
-        if (!head) 
-        {
-            head = tail = newEvent;
-        }
+        return capacity > INLINE_HOPS ? heap : local;
+    }
+
+    const unsigned short* cities() const 
+    {
+        return capacity > INLINE_HOPS ? heap : local;
+    }
+
+    void reserve(int n) 
+    {
+        if (n <= capacity) 
+            return;
+        int newCapacity = capacity * 2;
+        if (newCapacity < n) 
+            newCapacity = n;
+        unsigned short* grown = new unsigned short[newCapacity];
+        memcpy(grown, cities(), count * sizeof(unsigned short));
+        if (capacity > INLINE_HOPS) 
+            delete[] heap;
+        heap = grown;
+        capacity = newCapacity;
+    }
+
+    void release() 
+    {
+        if (capacity > INLINE_HOPS) 
+            delete[] heap;
+        count = 0;
+        capacity = INLINE_HOPS;
+    }
+
+    void steal(Route& other) 
+    {
+        count = other.count;
+        capacity = other.capacity;
+        if (capacity > INLINE_HOPS) 
+            heap = other.heap;
         else 
-        {
-            tail->next = newEvent;
-            tail = newEvent;
-        }
+            memcpy(local, other.local, count * sizeof(unsigned short));
+        other.count = 0;
+        other.capacity = INLINE_HOPS;
     }
 
-    void printTimeline() 
+public:
+    Route() : count(0), capacity(INLINE_HOPS) {}
+
+    Route(const Route& other) : count(0), capacity(INLINE_HOPS) 
+    {
+        *this = other;
+    }
+
+    Route(Route&& other) 
+    {
+        steal(other);
+    }
+
+    Route& operator=(const Route& other) 
     {
-        cout << "\n--- [TRACKING HISTORY] ---\n";
-        HistoryEvent* curr = head;
-        while (curr) 
+        if (this != &other) 
         {
-            cout << " [" << curr->time << "] " << curr->description << " @ " << curr->location << endl;
-            curr = curr->next;
+            count = 0;
+            reserve(other.count);
+            memcpy(cities(), other.cities(), other.count * sizeof(unsigned short));
+            count = other.count;
         }
-        cout << "--------------------------\n";
+        return *this;
     }
-    
-    TrackingHistory(const TrackingHistory& other) : head(nullptr), tail(nullptr) 
+
+    Route& operator=(Route&& other) 
     {
-        HistoryEvent* curr = other.head;
-        
-        while (curr) 
+        if (this != &other) 
         {
-            addEvent(curr->description, curr->location);
-            curr = curr->next;
+            release();
+            steal(other);
         }
+        return *this;
     }
-};
 
-struct Parcel 
-{
-    string id;
-    string destination;
-    double weight;
-    int priority; 
-    int status;
-    int priorityScore;
-    string assignedRider;
-    
-    string weightCategory; 
-    string zone;           
-    int deliveryAttempts;  
-    
-    long long dispatchTime; 
-    long long lastUpdateTime; 
-    long long arrivalTime;
-    long long lastKnownTime;
-    
-    TrackingHistory* history; 
-    
-    IntArrayList* currentRoute;
-    int currentRouteDistance;
-    int currentPosition;
-    
-    Parcel() : weight(0), priority(1), status(0), priorityScore(0), 
-               history(new TrackingHistory()), dispatchTime(0), lastUpdateTime(0), 
-               arrivalTime(0), deliveryAttempts(0), currentRoute(nullptr),
-               currentRouteDistance(0), currentPosition(0), lastKnownTime(0) {}
-    
-    Parcel(string pid, string dest, double w, int p, string z) : 
-           id(pid), destination(dest), weight(w), priority(p), 
-           status(STATUS_PICKUP_QUEUE), lastUpdateTime(0), arrivalTime(0), 
-           zone(z), deliveryAttempts(0), dispatchTime(0), currentRoute(nullptr),
-           currentRouteDistance(0), currentPosition(0), lastKnownTime(0) 
+    ~Route() 
     {
-        priorityScore = p * 1000 + (int)w; 
-        
-        if (w < 5.0) 
-            weightCategory = "Light";
-        else if (w < 20.0) 
-            weightCategory = "Medium";
-        else 
-            weightCategory = "Heavy";
+        release();
+    }
 
-        history = new TrackingHistory();
-        history->addEvent("Pickup Request Created", "Customer Loc");
+    void add(int city) 
+    {
+        reserve(count + 1);
+        cities()[count++] = (unsigned short)city;
     }
-    
-    void updateStatus(int newStatus, string desc, string loc) 
+
+    // Sets the length to n; the caller fills every hop with set().
+    void setSize(int n) 
     {
-        status = newStatus;
-        history->addEvent(desc, loc);
-        lastUpdateTime = time(0);
-        lastKnownTime = time(0);
+        reserve(n);
+        count = n;
     }
 
-    string getStatusString() const 
+    void set(int index, int city) 
     {
-        switch (status) 
-        {
-            case 0: return "Pickup Queue";
-            case 1: return "Warehouse (Sorted)";
-            case 2: return "Loading Vehicle";
-            case 3: return "In Transit";
-            case 4: return "Out for Delivery";
-            case 5: return "Delivered";
-            case 6: return "Returned to Sender";
-            case 7: return "MISSING";
-            case 8: return "Cancelled";
-            default: return "Unknown";
-        }
+        cities()[index] = (unsigned short)city;
     }
-    
-    ~Parcel() {
-        if (currentRoute) delete currentRoute;
+
+    int get(int index) const 
+    {
+        return (index >= 0 && index < count) ? cities()[index] : -1;
     }
-};
 
-ostream& operator<<(ostream& os, const Parcel& p) 
-{
-    os << left << setw(6) << p.id 
-       << setw(12) << p.destination 
-       << setw(8) << p.weightCategory
-       << setw(8) << p.zone
-       << " [" << p.getStatusString() << "]";
-    return os;
-}
+    int size() const 
+    {
+        return count;
+    }
 
-struct Rider {
-    string name;
-    string type;
-    int currentLoad;
-    int maxLoad;
-    bool available;
-    int parcelsAssigned;
-    
-    Rider(string n, string t, int max) : 
-          name(n), type(t), currentLoad(0), maxLoad(max), 
-          available(true), parcelsAssigned(0) {}
+    bool isEmpty() const 
+    {
+        return count == 0;
+    }
+
+    void clear() 
+    {
+        count = 0;
+    }
+
+    bool equals(const Route& other) const 
+    {
+        return count == other.count && 
+               memcmp(cities(), other.cities(), count * sizeof(unsigned short)) == 0;
+    }
 };
 
-class StringQueue 
+// Slab allocator for one node type. Objects are carved out of slabs of
+// SLAB_SIZE and recycled through a free list, so steady-state create and
+// destroy never reach malloc. Whoever creates an object owns it and must
+// destroy it through the same pool; the slabs go when the pool does.
+template <typename T> 
+class ObjectPool 
 {
 private:
-    struct Node 
-    { 
-        string data; 
-        Node* next; 
-        
-        Node(string d):data(d),next(nullptr){} 
+    static const int SLAB_SIZE = 256;
+
+    union Slot 
+    {
+        Slot* next;
+        alignas(T) unsigned char bytes[sizeof(T)];
     };
-    
-    Node* front; 
-    Node* rear;
+
+    struct Slab 
+    {
+        Slot slots[SLAB_SIZE];
+        Slab* next;
+    };
+
+    Slab* slabs;
+    Slot* freeList;
+    int live;
+    int slabCount;
+
+    void grow() 
+    {
+        Slab* slab = new Slab;
+        slab->next = slabs;
+        slabs = slab;
+        slabCount++;
+        for (int i = SLAB_SIZE - 1; i >= 0; i--) 
+        {
+            slab->slots[i].next = freeList;
+            freeList = &slab->slots[i];
+        }
+    }
 
 public:
-    StringQueue() : front(nullptr), rear(nullptr) {}
-    
-    void enqueue(string val) 
+    ObjectPool() : slabs(nullptr), freeList(nullptr), live(0), slabCount(0) {}
+
+    ~ObjectPool() 
     {
-        Node* n = new Node(val);
-        if(!rear) 
-            front = rear = n; 
-        else 
+        while (slabs) 
         {
-            rear->next = n;
-            rear = n; 
+            Slab* next = slabs->next;
+            delete slabs;
+            slabs = next;
         }
     }
-    
-    string dequeue() 
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    template <typename... Args> 
+    T* create(Args&&... args) 
     {
-        if(!front) 
-            return "";
-        
-        Node* temp = front; 
-        string val = front->data; 
-        front = front->next;
-        
-        if(!front) 
-            rear = nullptr; 
-        delete temp; 
-        return val;
+        if (!freeList) 
+            grow();
+        Slot* slot = freeList;
+        freeList = slot->next;
+        live++;
+        return new (slot->bytes) T(std::forward<Args>(args)...);
     }
-    
-    bool isEmpty() 
-    { 
-        return front == nullptr; 
+
+    void destroy(T* obj) 
+    {
+        if (!obj) 
+            return;
+        obj->~T();
+        Slot* slot = reinterpret_cast<Slot*>(obj);
+        slot->next = freeList;
+        freeList = slot;
+        live--;
     }
-};
 
-class ParcelArrayList 
+    int size() const 
+    {
+        return live;
+    }
+
+    long long reservedBytes() const 
+    {
+        return (long long)slabCount * sizeof(Slab);
+    }
+};
+
+class NameIndex 
 {
 private:
-    Parcel** data; 
-    int capacity; 
+    string* names;
+    int* slots;
     int count;
+    int nameCapacity;
+    int slotMask;
 
-    void resize(int newCapacity) 
+    static unsigned int hashName(const string& s) 
     {
-        Parcel** newData = new Parcel*[newCapacity];
-        for (int i = 0; i < count; i++) 
-            newData[i] = data[i];
-        delete[] data; 
-        data = newData; 
-        capacity = newCapacity;
+        unsigned int h = 2166136261u;
+        for (char c : s) 
+        {
+            h ^= (unsigned char)c;
+            h *= 16777619u;
+        }
+        return h;
     }
 
-public:
-    ParcelArrayList() : capacity(20), count(0) 
-    { 
-        data = new Parcel*[capacity]; 
+    void rehash(int slotCount) 
+    {
+        delete[] slots;
+        slots = new int[slotCount];
+        slotMask = slotCount - 1;
+        for(int i=0; i<slotCount; i++) 
+            slots[i] = -1;
+        for(int id=0; id<count; id++) 
+        {
+            int s = hashName(names[id]) & slotMask;
+            while (slots[s] != -1) 
+                s = (s + 1) & slotMask;
+            slots[s] = id;
+        }
     }
-    
-    ~ParcelArrayList() 
+
+public:
+    NameIndex() : slots(nullptr), count(0), nameCapacity(16) 
     {
-        delete[] data; 
+        names = new string[nameCapacity];
+        rehash(32);
     }
-    
-    void add(Parcel* val) 
-    { 
-        if (count == capacity) 
-            resize(capacity * 2); 
-        data[count++] = val; 
+
+    ~NameIndex() 
+    {
+        delete[] names;
+        delete[] slots;
     }
-    
-    void removeLast() 
+
+    int find(const string& name) const 
     {
-        if (count > 0) count--; 
+        int s = hashName(name) & slotMask;
+        while (slots[s] != -1) 
+        {
+            if (names[slots[s]] == name) 
+                return slots[s];
+            s = (s + 1) & slotMask;
+        }
+        return -1;
     }
-    
-    Parcel* get(int index) const 
-    { 
-        return (index >= 0 && index < count) ? data[index] : nullptr; 
+
+    int intern(const string& name) 
+    {
+        int id = find(name);
+        if (id != -1) 
+            return id;
+
+        if (count == nameCapacity) 
+        {
+            string* newNames = new string[nameCapacity * 2];
+            for(int i=0; i<count; i++) 
+                newNames[i] = names[i];
+            delete[] names;
+            names = newNames;
+            nameCapacity *= 2;
+        }
+        names[count++] = name;
+        if (count * 2 > slotMask + 1) 
+            rehash((slotMask + 1) * 2);
+        else 
+        {
+            int s = hashName(name) & slotMask;
+            while (slots[s] != -1) 
+                s = (s + 1) & slotMask;
+            slots[s] = count - 1;
+        }
+        return count - 1;
     }
-    
-    void set(int index, Parcel* val) 
+
+    const string& nameOf(int id) const 
     {
-        if (index >= 0 && index < count) 
-            data[index] = val; 
+        return names[id];
     }
-    
+
     int size() const 
     {
-        return count; 
-    }
-    
-    bool isEmpty() const 
-    { 
-        return count == 0; 
-    }
-    
-    void swap(int i, int j) 
-    { 
-        Parcel* temp = data[i]; 
-        data[i] = data[j]; 
-        data[j] = temp; 
+        return count;
     }
 };
 
-struct ParcelNode 
+class MapGraph;
+
+enum TrackingEvent 
 {
-    Parcel* data; 
-    ParcelNode* next;
-    
-    ParcelNode(Parcel* val) : data(val), next(nullptr) {}
+    EV_PICKUP_CREATED,
+    EV_ARRIVED_WAREHOUSE,
+    EV_ARRIVED_WAREHOUSE_BULK,
+    EV_NO_ROUTE,
+    EV_ROUTE_ISSUE,
+    EV_LOADING,
+    EV_DEPARTED,
+    EV_SIGNAL_TIMEOUT,
+    EV_SIGNAL_LOST,
+    EV_ARRIVED_HUB,
+    EV_DELIVERED,
+    EV_MAX_ATTEMPTS,
+    EV_RETRY,
+    EV_REROUTED,
+    EV_CANCELLED,
+    EV_CANCELLED_IN_TRANSIT,
+    EV_UNDO_ADD,
+    EV_UNDO_DISPATCH,
+    EV_COUNT
 };
 
-struct Edge 
-{ 
-    int dest; 
-    int weight; 
-    bool blocked; 
-    int currentLoad;
-    int maxLoad;
-    
-    Edge(int d=0, int w=0, int maxL=10) : 
-        dest(d), weight(w), blocked(false), currentLoad(0), maxLoad(maxL) {} 
-    
-    bool isOverloaded() {
-        return currentLoad >= maxLoad;
-    }
+// Locations interned up front, in this order, so their ids are constants.
+enum KnownLocation 
+{
+    LOC_CUSTOMER,
+    LOC_CENTRAL_HUB,
+    LOC_WAREHOUSE,
+    LOC_BAY,
+    LOC_ON_ROAD,
+    LOC_UNKNOWN,
+    LOC_DOORSTEP,
+    LOC_LOCAL_HUB,
+    LOC_SYSTEM,
+    LOC_IN_TRANSIT,
+    LOC_NONE,
+    LOC_KNOWN_COUNT
 };
 
-class EdgeArrayList 
+const char* const KNOWN_LOCATIONS[LOC_KNOWN_COUNT] = 
+{
+    "Customer Loc", "Central Hub", "Warehouse", "Bay 4", "On Road", "Unknown", 
+    "Doorstep", "Local Hub", "System", "In Transit", "N/A"
+};
+
+struct TrackingEventInfo 
+{
+    const char* description;
+    int location;
+};
+
+// Indexed by TrackingEvent: the text shown in the timeline and where the
+// event normally happens (-1 when the caller supplies the location).
+const TrackingEventInfo TRACKING_EVENTS[EV_COUNT] = 
+{
+    {"Pickup Request Created", LOC_CUSTOMER},
+    {"Arrived at Warehouse", LOC_CENTRAL_HUB},
+    {"Arrived at Warehouse (Bulk Manifest)", LOC_CENTRAL_HUB},
+    {"No Route Available", LOC_WAREHOUSE},
+    {"Dynamic Route Issue - RTS", LOC_WAREHOUSE},
+    {"Loading onto Truck", LOC_BAY},
+    {"Vehicle Departed", LOC_ON_ROAD},
+    {"No Signal for 15+ Seconds - Marked Missing", LOC_UNKNOWN},
+    {"Signal Lost - Investigation Started", LOC_UNKNOWN},
+    {"Arrived at Destination Hub", -1},
+    {"Handed to Recipient", LOC_DOORSTEP},
+    {"Max Attempts Reached - RTS", LOC_LOCAL_HUB},
+    {"Recipient Unavailable - Retrying", LOC_LOCAL_HUB},
+    {"Route Recalculated Due to Blockage", LOC_SYSTEM},
+    {"Cancelled by User", LOC_WAREHOUSE},
+    {"Cancelled During Transit - Returning", LOC_IN_TRANSIT},
+    {"Undo: Creation Reverted", LOC_NONE},
+    {"Undo: Dispatch Reverted", LOC_WAREHOUSE}
+};
+
+class LocationTable 
 {
 private:
-    Edge* data; 
-    int capacity; 
-    int count;
-    
-    void resize(int newCapacity) 
-    {
-        Edge* newData = new Edge[newCapacity]; 
-        for(int i=0; i<count; i++) 
-            newData[i] = data[i];
-        
-        delete[] data; 
-        data = newData; 
-        capacity = newCapacity;
-    }
+    NameIndex names;
 
 public:
-    EdgeArrayList() : capacity(5), count(0) 
-    { 
-        data = new Edge[capacity]; 
-    }
-    
-    EdgeArrayList(const EdgeArrayList& other) 
+    LocationTable() 
     {
-        capacity = other.capacity; 
-        count = other.count; 
-        data = new Edge[capacity];
-        
-        for(int i=0; i<count; i++) 
-            data[i] = other.data[i];
+        for (int i = 0; i < LOC_KNOWN_COUNT; i++) 
+            names.intern(KNOWN_LOCATIONS[i]);
     }
-    
-    EdgeArrayList& operator=(const EdgeArrayList& other) 
+
+    int intern(const string& name) 
     {
-        if(this != &other) 
-        {
-            delete[] data; 
-            capacity = other.capacity; 
-            count = other.count; 
-            data = new Edge[capacity];
-            
-            for(int i=0; i<count; i++) 
-                data[i] = other.data[i];
-        }
-        return *this;
+        return names.intern(name);
     }
 
-    ~EdgeArrayList() 
-    { 
-        delete[] data; 
-    }
-    
-    void add(Edge val) 
-    { 
-        if (count == capacity) 
-            resize(capacity * 2); 
-        data[count++] = val; 
-    }
-    
-    int size() const 
-    { 
-        return count; 
-    }
-    
-    Edge& getRef(int i) 
-    { 
-        return data[i]; 
+    const string& nameOf(int id) const 
+    {
+        return names.nameOf(id);
     }
 };
 
-struct CityNode 
-{ 
-    string name;
-    string zone; 
-    EdgeArrayList edges; 
-    
-    CityNode(string n="", string z="") : name(n), zone(z) {} 
+LocationTable locations;
+
+struct TrackingRecord 
+{
+    long long timeMs;
+    short event;
+    short reserved;
+    int location;
 };
 
-class MapGraph 
+// Fixed-size block of a parcel's event log; sized to 128 bytes.
+struct TrackingChunk 
 {
-public:
-    CityNode* cities; 
-    int cityCount; 
-    int cityCapacity;
-    
-    IntArrayList availablePaths[5]; 
-    int availablePathDistances[5];
-    int pathCount;
+    static const int CAPACITY = 7;
+    TrackingRecord records[CAPACITY];
+    int count;
+    TrackingChunk* next;
 
-    MapGraph() : cityCount(0), cityCapacity(200) 
-    { 
-        cities = new CityNode[cityCapacity]; 
-    }
+    TrackingChunk() : count(0), next(nullptr) {}
+};
 
-    int addCity(string name, string zone) 
-    { 
-        if (cityCount == cityCapacity) 
-            return -1; 
-        cities[cityCount] = CityNode(name, zone); 
-        return cityCount++; 
-    }
-    
-    void addRoad(int u, int v, int dist, int maxLoad = 10) 
-    { 
-        cities[u].edges.add(Edge(v, dist, maxLoad)); 
-        cities[v].edges.add(Edge(u, dist, maxLoad)); 
-    }
+// Shared by every TrackingHistory; a history owns its chunks.
+ObjectPool<TrackingChunk> trackingChunks;
+
+// Append-only log of 16-byte records kept in pooled chunks. Nothing is
+// formatted until the timeline is printed.
+class TrackingHistory 
+{
+private:
+    TrackingChunk* head;
+    TrackingChunk* tail;
+    int count;
+
+public:
+    TrackingHistory() : head(nullptr), tail(nullptr), count(0) {}
     
-    int getCityIndex(string name) 
-    { 
-        for(int i=0; i<cityCount; i++) 
-            if (cities[i].name == name) 
-                return i; 
-        
-        return -1; 
+    void addEvent(int event, int location, long long timeMs) 
+    {
+        if (!tail || tail->count == TrackingChunk::CAPACITY) 
+        {
+            TrackingChunk* chunk = trackingChunks.create();
+            if (tail) 
+                tail->next = chunk;
+            else 
+                head = chunk;
+            tail = chunk;
+        }
+        TrackingRecord& r = tail->records[tail->count++];
+        r.timeMs = timeMs;
+        r.event = (short)event;
+        r.reserved = 0;
+        r.location = location;
+        count++;
     }
-    
-    string getZone(string name) 
+
+    void addEvent(int event) 
     {
-        int idx = getCityIndex(name);
-        if(idx != -1) 
-            return cities[idx].zone;
+        addEvent(event, TRACKING_EVENTS[event].location, nowMs());
+    }
 
-        return "Unknown";
+    int size() const 
+    {
+        return count;
     }
 
-    void displayAllCities() 
+    // Calls fn(index, record) for every event, oldest first.
+    template <typename Fn> 
+    void forEach(Fn fn) const 
     {
-        cout << "\n=========================================\n      AVAILABLE CITIES FOR DELIVERY\n=========================================\n";
-        cout << left << setw(25) << "CITY NAME" << setw(15) << "ZONE" << endl;
-        cout << "-----------------------------------------\n";
-        
-        for(int i=0; i<cityCount; i++) 
-        {
-            cout << left << setw(25) << cities[i].name << setw(15) << cities[i].zone << endl;
-        }
-        
-        cout << "\nTotal Cities: " << cityCount << endl;
-        cout << "=========================================\n";
+        int i = 0;
+        for (TrackingChunk* c = head; c; c = c->next) 
+            for (int k = 0; k < c->count; k++) 
+                fn(i++, c->records[k]);
     }
 
-    void blockRandomRoad() 
+    void clear() 
     {
-        if (cityCount < 2) 
-            return;
-        int u = rand() % cityCount;
-        if (cities[u].edges.size() > 0) 
+        while (head) 
         {
-            int eIdx = rand() % cities[u].edges.size();
-            cities[u].edges.getRef(eIdx).blocked = true;
-            cout << ">>> [ALERT] Road near " << cities[u].name << " is now BLOCKED!\n";
-        }
-    }
-    
-    void checkOverloads() {
-        for(int i=0; i<cityCount; i++) {
-            EdgeArrayList& edges = cities[i].edges;
-            for(int k=0; k<edges.size(); k++) {
-                Edge& e = edges.getRef(k);
-                if (e.isOverloaded() && !e.blocked) {
-                    e.blocked = true;
-                    cout << ">>> [ALERT] Road " << cities[i].name << " -> " 
-                         << cities[e.dest].name << " is OVERLOADED! Temporarily blocked.\n";
-                }
-            }
-        }
-    }
-    
-    void updateEdgeLoad(IntArrayList& path, int increment) {
-        for(int i=0; i<path.size()-1; i++) {
-            int city1 = path.get(i);
-            int city2 = path.get(i+1);
-            
-            EdgeArrayList& edges = cities[city1].edges;
-            for(int j=0; j<edges.size(); j++) {
-                if (edges.getRef(j).dest == city2) {
-                    edges.getRef(j).currentLoad += increment;
-                    break;
-                }
-            }
+            TrackingChunk* next = head->next;
+            trackingChunks.destroy(head);
+            head = next;
         }
+        tail = nullptr;
+        count = 0;
     }
 
-    void displayNetwork() 
+    void printTimeline() 
     {
-        clearScreen();
-        cout << "\n=========================================\n      LOGISTICS NETWORK MAP VIEW\n=========================================\n";
-        for(int i=0; i<cityCount; i++) 
+        out() << "\n--- [TRACKING HISTORY] ---\n";
+        for (TrackingChunk* c = head; c; c = c->next) 
         {
-            cout << " [" << cities[i].zone << "] " << left << setw(12) << cities[i].name << " connects to:\n";
-            EdgeArrayList& edges = cities[i].edges;
-            
-            for(int k=0; k<edges.size(); k++) 
+            for (int i = 0; i < c->count; i++) 
             {
-                Edge& e = edges.getRef(k);
-                cout << "    --> " << setw(12) << cities[e.dest].name << " | " << e.weight << "km";
-                if(e.blocked) cout << " [BLOCKED]";
-                if(e.isOverloaded()) cout << " [OVERLOADED: " << e.currentLoad << "/" << e.maxLoad << "]";
-                else if(e.currentLoad > 0) cout << " [Load: " << e.currentLoad << "/" << e.maxLoad << "]";
-                cout << endl;
+                const TrackingRecord& r = c->records[i];
+                out() << " [" << formatClock(r.timeMs) << "] " << TRACKING_EVENTS[r.event].description 
+                      << " @ " << locations.nameOf(r.location) << endl;
             }
-            cout << "-----------------------------------------\n";
         }
+        out() << "--------------------------\n";
     }
-
-    void findAllPaths(int start, int end) 
+    
+    TrackingHistory(const TrackingHistory& other) : head(nullptr), tail(nullptr), count(0) 
     {
-        bool* visited = new bool[cityCount];
-        for(int i=0; i<cityCount; i++) 
-            visited[i] = false;
-        pathCount = 0;
-        IntArrayList currentPath;
-        
-        solveDFS(start, end, visited, currentPath, 0);
-        
-        delete[] visited;
+        for (TrackingChunk* c = other.head; c; c = c->next) 
+            for (int i = 0; i < c->count; i++) 
+                addEvent(c->records[i].event, c->records[i].location, c->records[i].timeMs);
     }
 
-    void solveDFS(int u, int d, bool visited[], IntArrayList currentPath, int currentDist) 
+    TrackingHistory& operator=(const TrackingHistory&) = delete;
+
+    ~TrackingHistory() 
     {
-        visited[u] = true;
-        currentPath.add(u);
-        
-        if (u == d) 
-        {
-             if (pathCount < 5) 
-             {
-                availablePaths[pathCount] = currentPath; 
-                availablePathDistances[pathCount] = currentDist;
-                pathCount++;
-            }
-        } 
-        else 
-        {
-            EdgeArrayList& edges = cities[u].edges;
-            for(int i=0; i<edges.size(); i++) 
-            {
-                Edge& e = edges.getRef(i);
-                if(!visited[e.dest] && !e.blocked && !e.isOverloaded()) 
-                {
-                    solveDFS(e.dest, d, visited, currentPath, currentDist + e.weight);
-                }
-            }
-        }
-        visited[u] = false;
-    }
-    
-    int getMinRouteIndex() 
-    {
-        int minIdx = -1;
-        int minDist = INT_MAX;
-        for(int i=0; i<pathCount; i++) 
-        {
-            if(availablePathDistances[i] < minDist) 
-            {
-                minDist = availablePathDistances[i];
-                minIdx = i;
-            }
-        }
-        return minIdx;
+        clear();
     }
 };
 
-class ParcelLinkedList 
+struct Parcel;
+
+class ParcelObserver 
 {
-private:
-    ParcelNode* head; 
-    ParcelNode* tail;
-    
 public:
-    ParcelLinkedList() : head(nullptr), tail(nullptr) {}
-    
-    void pushBack(Parcel* val) 
+    virtual ~ParcelObserver() {}
+    virtual void onStatusChanged(Parcel* p, int oldStatus) = 0;
+    virtual void onRiderChanged(Parcel* p, int oldRider) = 0;
+};
+
+enum ParcelIndexKind 
+{
+    INDEX_STATUS,
+    INDEX_ZONE,
+    INDEX_STATUS_ZONE,
+    INDEX_DESTINATION,
+    INDEX_RIDER,
+    INDEX_KIND_COUNT
+};
+
+struct ParcelLink 
+{
+    Parcel* prev;
+    Parcel* next;
+    ParcelLink() : prev(nullptr), next(nullptr) {}
+};
+
+// Hot parcel fields, one dense column per field, indexed by the parcel's
+// slot id. The tick loops stream through these columns and only touch the
+// Parcel record itself (strings, history, list links) when a parcel
+// actually changes state. Freed slots are recycled and read as SLOT_FREE.
+class ParcelStore 
+{
+private:
+    int capacity;
+    int used;
+    int live;
+    int* freeSlots;
+    int freeCount;
+
+    template <typename T> 
+    static void growColumn(T*& column, int count, int newCapacity) 
     {
-        ParcelNode* newNode = new ParcelNode(val);
-        if (!tail) 
-        { 
-            head = tail = newNode; 
-        } 
-        else 
-        { 
-            tail->next = newNode; 
-            tail = newNode; 
-        }
+        T* grown = new T[newCapacity];
+        for (int i = 0; i < count; i++) 
+            grown[i] = column[i];
+        delete[] column;
+        column = grown;
     }
-    
-    void recalculateRoutes(MapGraph* map) {
-        ParcelNode* curr = head;
-        while(curr) 
-        {
-            Parcel* p = curr->data;
-            if (p->status == STATUS_IN_TRANSIT && p->currentRoute) {
-                bool routeBlocked = false;
-                for(int i = p->currentPosition; i < p->currentRoute->size() - 1; i++) {
-                    int city1 = p->currentRoute->get(i);
-                    int city2 = p->currentRoute->get(i + 1);
-                    if (rand() % 20 == 0) {
-                        routeBlocked = true;
-                        break;
-                    }
-                }
-                
-                if (routeBlocked) {
-                    int start = p->currentRoute->get(p->currentPosition);
-                    int end = map->getCityIndex(p->destination);
-                    map->findAllPaths(start, end);
-                    
-                    if (map->pathCount > 0) {
-                        int minIdx = map->getMinRouteIndex();
-                        delete p->currentRoute;
-                        p->currentRoute = new IntArrayList(map->availablePaths[minIdx]);
-                        p->currentRouteDistance = map->availablePathDistances[minIdx];
-                        p->history->addEvent("Route Recalculated Due to Blockage", "System");
-                        cout << ">>> Route recalculated for parcel " << p->id << endl;
-                    }
-                }
-            }
-            curr = curr->next;
-        }
+
+    void grow() 
+    {
+        int newCapacity = capacity * 2;
+        growColumn(status, used, newCapacity);
+        growColumn(lastUpdateTime, used, newCapacity);
+        growColumn(lastKnownTime, used, newCapacity);
+        growColumn(nextHopTime, used, newCapacity);
+        growColumn(arrivalTime, used, newCapacity);
+        growColumn(dispatchTime, used, newCapacity);
+        growColumn(currentPosition, used, newCapacity);
+        growColumn(routeLength, used, newCapacity);
+        growColumn(deliveryAttempts, used, newCapacity);
+        growColumn(rngKey, used, newCapacity);
+        growColumn(rngDraws, used, newCapacity);
+        growColumn(zone, used, newCapacity);
+        growColumn(owner, used, newCapacity);
+        growColumn(freeSlots, freeCount, newCapacity);
+        capacity = newCapacity;
     }
-    
-    void updateLifecycle(long long currentTime, MapGraph* map) 
+
+public:
+    static const unsigned char SLOT_FREE = 0xff;
+    static const unsigned char NO_ZONE = 0xff;
+
+    unsigned char* status;
+    unsigned char* zone;
+    long long* lastUpdateTime;
+    long long* lastKnownTime;
+    long long* nextHopTime;
+    long long* arrivalTime;
+    long long* dispatchTime;
+    int* currentPosition;
+    int* routeLength;
+    int* deliveryAttempts;
+    unsigned long long* rngKey;
+    unsigned int* rngDraws;
+    Parcel** owner;
+
+    ParcelStore() : capacity(1024), used(0), live(0), freeCount(0) 
     {
-        ParcelNode* curr = head;
-        while(curr) 
-        {
-            Parcel* p = curr->data;
-            
-            if (p->status == STATUS_IN_TRANSIT && (currentTime - p->lastKnownTime) > 15) {
-                p->updateStatus(STATUS_MISSING, "No Signal for 15+ Seconds - Marked Missing", "Unknown");
-                cout << ">>> ALERT: Parcel " << p->id << " marked as MISSING!\n";
-            }
-            
-            if (p->status == STATUS_LOADING) 
-            {
-                if (currentTime >= p->lastUpdateTime + 5) 
-                {
-                    p->updateStatus(STATUS_IN_TRANSIT, "Vehicle Departed", "On Road");
-                    p->lastKnownTime = currentTime;
-                }
-            }
-            else if (p->status == STATUS_IN_TRANSIT) 
-            {
-                if (p->currentRoute && p->currentPosition < p->currentRoute->size() - 1) {
-                    if (currentTime % 3 == 0) {
-                        p->currentPosition = min(p->currentPosition + 1, p->currentRoute->size() - 1);
-                    }
-                }
-                
-                if (rand() % 1000 == 0) 
-                {
-                    p->updateStatus(STATUS_MISSING, "Signal Lost - Investigation Started", "Unknown");
-                }
-                else if (currentTime >= p->arrivalTime) 
-                {
-                    p->updateStatus(STATUS_DELIVERY_ATTEMPT, "Arrived at Destination Hub", p->destination);
-                }
-            }
-            else if (p->status == STATUS_DELIVERY_ATTEMPT) 
-            {
-                if (rand() % 10 < 8) 
-                {
-                    p->updateStatus(STATUS_DELIVERED, "Handed to Recipient", "Doorstep");
-                } 
-                else 
-                {
-                    p->deliveryAttempts++;
-                    if (p->deliveryAttempts >= 3) 
-                    {
-                        p->updateStatus(STATUS_RETURNED, "Max Attempts Reached - RTS", "Local Hub");
-                    } 
-                    else 
-                    {
-                        p->updateStatus(STATUS_IN_TRANSIT, "Recipient Unavailable - Retrying", "Local Hub");
-                        p->arrivalTime = currentTime + 5; 
-                    }
-                }
-            }
-            curr = curr->next;
-        }
+        status = new unsigned char[capacity];
+        zone = new unsigned char[capacity];
+        lastUpdateTime = new long long[capacity];
+        lastKnownTime = new long long[capacity];
+        nextHopTime = new long long[capacity];
+        arrivalTime = new long long[capacity];
+        dispatchTime = new long long[capacity];
+        currentPosition = new int[capacity];
+        routeLength = new int[capacity];
+        deliveryAttempts = new int[capacity];
+        rngKey = new unsigned long long[capacity];
+        rngDraws = new unsigned int[capacity];
+        owner = new Parcel*[capacity];
+        freeSlots = new int[capacity];
     }
 
-    void showTransitStatus(long long currentTime) 
+    ~ParcelStore() 
     {
-        ParcelNode* curr = head; bool headerPrinted = false;
-        while(curr) 
-        {
-            if (curr->data->status == STATUS_IN_TRANSIT || curr->data->status == STATUS_LOADING) 
-            {
-                if (!headerPrinted) 
-                { 
-                    cout << "\n--- [LIVE TRANSIT MONITOR] ---\n"; 
-                    headerPrinted = true; 
-                }
-                
-                long long total = curr->data->arrivalTime - curr->data->dispatchTime;
-                long long elapsed = currentTime - curr->data->dispatchTime;
-                
-                string state = (curr->data->status == STATUS_LOADING) ? "[LOADING] " : "[MOVING]  ";
-                
-                if(total<=0) total=1;
-                double pct = (double)elapsed/total;
-                if(pct>1.0) pct=1.0;
-                
-                cout << state << curr->data->id << " -> " << curr->data->destination << ": [";
-                int bars = (int)(pct * 20);
-                for(int i=0; i<20; i++) cout << (i < bars ? "=" : " ");
-                cout << "] " << (int)(pct * 100) << "%";
-                
-                if (curr->data->currentRoute && curr->data->currentPosition > 0) {
-                    cout << " (At position " << curr->data->currentPosition << "/" 
-                         << curr->data->currentRoute->size() << ")";
-                }
-                cout << "\n";
-            }
-            curr = curr->next;
-        }
-        
-        if (!headerPrinted) 
-            cout << "\n(No parcels active in transit)\n";
+        delete[] status;
+        delete[] zone;
+        delete[] lastUpdateTime;
+        delete[] lastKnownTime;
+        delete[] nextHopTime;
+        delete[] arrivalTime;
+        delete[] dispatchTime;
+        delete[] currentPosition;
+        delete[] routeLength;
+        delete[] deliveryAttempts;
+        delete[] rngKey;
+        delete[] rngDraws;
+        delete[] owner;
+        delete[] freeSlots;
     }
-};
 
-class ParcelHeap 
-{
-private:
-    ParcelArrayList heap;
-    
-    void heapifyUp(int index) 
+    ParcelStore(const ParcelStore&) = delete;
+    ParcelStore& operator=(const ParcelStore&) = delete;
+
+    // Returns a zeroed slot owned by p. Columns may move, so callers keep
+    // slot ids, never pointers into a column.
+    int allocate(Parcel* p) 
     {
-        while (index > 0) 
+        int slot;
+        if (freeCount > 0) 
+            slot = freeSlots[--freeCount];
+        else 
         {
-            int parent = (index - 1) / 2;
-            if (heap.get(index)->priorityScore > heap.get(parent)->priorityScore) 
-            {
-                heap.swap(index, parent); 
-                index = parent;
-            } 
-            else 
-                break;
+            if (used == capacity) 
+                grow();
+            slot = used++;
         }
+        status[slot] = 0;
+        zone[slot] = NO_ZONE;
+        lastUpdateTime[slot] = lastKnownTime[slot] = nextHopTime[slot] = 0;
+        arrivalTime[slot] = dispatchTime[slot] = 0;
+        currentPosition[slot] = routeLength[slot] = deliveryAttempts[slot] = 0;
+        rngKey[slot] = 0;
+        rngDraws[slot] = 0;
+        owner[slot] = p;
+        live++;
+        return slot;
     }
-    
-    void heapifyDown(int index) 
+
+    void release(int slot) 
     {
-        int left = 2 * index + 1, right = 2 * index + 2, largest = index;
-        
-        if (left < heap.size() && heap.get(left)->priorityScore > heap.get(largest)->priorityScore) 
-            largest = left;
-        if (right < heap.size() && heap.get(right)->priorityScore > heap.get(largest)->priorityScore) 
-            largest = right;
-        if (largest != index) 
-        { 
-            heap.swap(index, largest);
-            heapifyDown(largest);
-        }
+        status[slot] = SLOT_FREE;
+        owner[slot] = nullptr;
+        freeSlots[freeCount++] = slot;
+        live--;
     }
 
-public:
-    void insert(Parcel* val) 
-    { 
-        heap.add(val); 
-        heapifyUp(heap.size() - 1); 
-    }
-    
-    Parcel* extractMax() 
+    // Slots in use are below this bound; some of them may be free.
+    int slotCount() const 
     {
-        if (heap.isEmpty()) 
-            return nullptr;
-        
-        Parcel* maxVal = heap.get(0);
-        heap.set(0, heap.get(heap.size() - 1));
-        heap.removeLast();
-        if (!heap.isEmpty()) 
-            heapifyDown(0);
-        
-        return maxVal;
-    }
-    
-    bool isEmpty() 
-    { 
-        return heap.isEmpty(); 
+        return used;
     }
-    
-    int size() 
+
+    int liveCount() const 
     {
-        return heap.size();
+        return live;
     }
-};
 
-struct HashEntry 
-{ 
-    string key; 
-    Parcel* value; 
-    bool occupied; 
-    HashEntry() : key(""), value(nullptr), occupied(false) {} 
+    // Counter-based draw from the slot's own stream: the result depends
+    // only on simSeed, the parcel id and how many draws it has made, never
+    // on which thread asks or in what order parcels are processed.
+    unsigned int nextRandom(int slot) 
+    {
+        unsigned int draw = ++rngDraws[slot];
+        return (unsigned int)(mix64(simSeed ^ mix64(rngKey[slot] + 0x9e3779b97f4a7c15ULL * draw)) >> 32);
+    }
 };
 
-class ParcelHashTable 
+// Interned routes. Parcels driving the same city sequence share one
+// entry, so route memory grows with the number of distinct routes rather
+// than with the number of parcels, and two routes are equal exactly when
+// their ids are. Entries are reference counted by the parcels holding
+// them; an id is recycled once its last parcel lets go.
+class RouteTable 
 {
 private:
-    HashEntry* table; 
+    Route* routes;
+    unsigned int* hashes;
+    int* refs;
+    int* freeIds;
+    int freeCount;
+    int used;
     int capacity;
-    int hashFunction(const string& key) 
+    int live;
+    int references;
+    int* slots;
+    int slotMask;
+
+    static unsigned int hashRoute(const Route& r) 
     {
-        unsigned long hash = 5381;
-        for (char c : key) 
-            hash = ((hash << 5) + hash) + c;
-        return hash % capacity;
+        unsigned int h = 2166136261u;
+        for (int i = 0; i < r.size(); i++) 
+        {
+            h ^= (unsigned int)r.get(i);
+            h *= 16777619u;
+        }
+        return h;
     }
 
-public:
-    ParcelHashTable(int cap = 1007) : capacity(cap) 
-    { 
-        table = new HashEntry[capacity]; 
+    void place(int id) 
+    {
+        int s = hashes[id] & slotMask;
+        while (slots[s] != -1) 
+            s = (s + 1) & slotMask;
+        slots[s] = id;
     }
-    
-    ~ParcelHashTable() 
+
+    void rehash(int slotCount) 
     {
-        delete[] table; 
+        delete[] slots;
+        slots = new int[slotCount];
+        slotMask = slotCount - 1;
+        for (int i = 0; i < slotCount; i++) 
+            slots[i] = -1;
+        for (int id = 0; id < used; id++) 
+            if (refs[id] > 0) 
+                place(id);
     }
-    
-    void insert(string key, Parcel* value) 
+
+    void grow() 
     {
-        int index = hashFunction(key); 
-        int i = 0;
-        while (i < capacity) 
+        int newCapacity = capacity * 2;
+        Route* newRoutes = new Route[newCapacity];
+        unsigned int* newHashes = new unsigned int[newCapacity];
+        int* newRefs = new int[newCapacity];
+        int* newFree = new int[newCapacity];
+        for (int i = 0; i < used; i++) 
+        {
+            newRoutes[i] = move(routes[i]);
+            newHashes[i] = hashes[i];
+            newRefs[i] = refs[i];
+        }
+        for (int i = 0; i < freeCount; i++) 
+            newFree[i] = freeIds[i];
+        delete[] routes;
+        delete[] hashes;
+        delete[] refs;
+        delete[] freeIds;
+        routes = newRoutes;
+        hashes = newHashes;
+        refs = newRefs;
+        freeIds = newFree;
+        capacity = newCapacity;
+    }
+
+    // Linear-probing delete: shifts later entries of the same probe run
+    // back into the hole so lookups never need tombstones.
+    void unplace(int id) 
+    {
+        int hole = hashes[id] & slotMask;
+        while (slots[hole] != id) 
+            hole = (hole + 1) & slotMask;
+        for (int s = (hole + 1) & slotMask; slots[s] != -1; s = (s + 1) & slotMask) 
         {
-            int probe = (index + i * i) % capacity;
-            if (!table[probe].occupied || table[probe].key == key) 
+            int home = hashes[slots[s]] & slotMask;
+            if (((s - home) & slotMask) >= ((s - hole) & slotMask)) 
             {
-                table[probe].key = key; 
-                table[probe].value = value; 
-                table[probe].occupied = true; 
-                return;
+                slots[hole] = slots[s];
+                hole = s;
             }
-            i++;
         }
+        slots[hole] = -1;
     }
-    
-    Parcel* search(string key) 
+
+public:
+    RouteTable() : freeCount(0), used(0), capacity(64), live(0), references(0), slots(nullptr) 
     {
-        int index = hashFunction(key); 
-        int i = 0;
-        while (i < capacity) 
-        {
-            int probe = (index + i * i) % capacity;
+        routes = new Route[capacity];
+        hashes = new unsigned int[capacity];
+        refs = new int[capacity];
+        freeIds = new int[capacity];
+        rehash(128);
+    }
 
-            if (!table[probe].occupied) 
-                return nullptr;
-            
-            if (table[probe].key == key) 
-                return table[probe].value;
-            i++;
-        }
-        return nullptr;
+    ~RouteTable() 
+    {
+        delete[] routes;
+        delete[] hashes;
+        delete[] refs;
+        delete[] freeIds;
+        delete[] slots;
     }
-    
-    void printAll() 
+
+    RouteTable(const RouteTable&) = delete;
+    RouteTable& operator=(const RouteTable&) = delete;
+
+    int find(const Route& route) const 
     {
-        clearScreen();
-        cout << "\n=========================================\n           SYSTEM DATABASE\n=========================================\n";
-        cout << "ID     DEST         CAT     ZONE     STATUS\n";
-        for(int i=0; i<capacity; i++) 
-            if(table[i].occupied) 
-                cout << *table[i].value << endl;
-        cout << "-----------------------------------------\n";
+        unsigned int h = hashRoute(route);
+        for (int s = h & slotMask; slots[s] != -1; s = (s + 1) & slotMask) 
+        {
+            int id = slots[s];
+            if (hashes[id] == h && routes[id].equals(route)) 
+                return id;
+        }
+        return -1;
     }
-};
 
-struct UndoAction 
-{ 
-    string type; 
-    string parcelId; 
-};
+    // Returns the canonical id for route and takes one reference on it.
+    int acquire(const Route& route) 
+    {
+        int id = find(route);
+        if (id == -1) 
+        {
+            if ((live + 1) * 2 > slotMask + 1) 
+                rehash((slotMask + 1) * 2);
+            if (freeCount > 0) 
+                id = freeIds[--freeCount];
+            else 
+            {
+                if (used == capacity) 
+                    grow();
+                id = used++;
+            }
+            routes[id] = route;
+            hashes[id] = hashRoute(route);
+            refs[id] = 0;
+            live++;
+            place(id);
+        }
+        refs[id]++;
+        references++;
+        return id;
+    }
 
-struct UndoNode 
-{ 
-    UndoAction data; 
-    UndoNode* next; 
-    UndoNode(UndoAction d) : data(d), next(nullptr) {} 
-};
+    void release(int id) 
+    {
+        if (id < 0) 
+            return;
+        references--;
+        if (--refs[id] > 0) 
+            return;
+        unplace(id);
+        routes[id].clear();
+        freeIds[freeCount++] = id;
+        live--;
+    }
 
-class ActionStack 
-{
-private:
-    UndoNode* topNode;
+    // The route for id; -1 is the empty route.
+    const Route& route(int id) const 
+    {
+        static const Route none;
+        return id < 0 ? none : routes[id];
+    }
 
-public:
-    ActionStack() : topNode(nullptr) {}
-    
-    void push(string type, string id) 
-    { 
-        UndoNode* n = new UndoNode({type, id}); 
-        n->next = topNode; 
-        topNode = n; 
+    int distinct() const 
+    {
+        return live;
     }
-    
-    bool pop(UndoAction& dest) 
+
+    int holders() const 
     {
-        if(!topNode) 
-            return false;
-        
-        UndoNode* temp = topNode; 
-        dest = temp->data; 
-        topNode = topNode->next; 
-        delete temp; 
-        
-        return true;
+        return references;
     }
 };
 
-class RiderManager {
-private:
-    Rider* riders;
-    int riderCount;
-    
-public:
-    RiderManager() : riderCount(4) {
+// Column scans over the parcel store. Both kernels read the status bytes
+// a whole vector at a time: 32 lanes with AVX2, 16 with SSE2, and a plain
+// loop otherwise. Free slots read as SLOT_FREE and never match.
+#if defined(SWIFTEX_AVX2)
+typedef __m256i ByteLanes;
+const int BYTE_LANES = 32;
+
+inline ByteLanes lanesLoad(const unsigned char* p) 
+{
+    return _mm256_loadu_si256((const __m256i*)p);
+}
+
+inline ByteLanes lanesSplat(int v) 
+{
+    return _mm256_set1_epi8((char)v);
+}
+
+inline ByteLanes lanesZero() 
+{
+    return _mm256_setzero_si256();
+}
+
+inline ByteLanes lanesEqual(ByteLanes a, ByteLanes b) 
+{
+    return _mm256_cmpeq_epi8(a, b);
+}
+
+inline ByteLanes lanesAnd(ByteLanes a, ByteLanes b) 
+{
+    return _mm256_and_si256(a, b);
+}
+
+inline ByteLanes lanesSub(ByteLanes a, ByteLanes b) 
+{
+    return _mm256_sub_epi8(a, b);
+}
+
+inline ByteLanes lanesOr(ByteLanes a, ByteLanes b) 
+{
+    return _mm256_or_si256(a, b);
+}
+
+inline ByteLanes lanesAndNot(ByteLanes a, ByteLanes b) 
+{
+    return _mm256_andnot_si256(a, b);
+}
+
+inline unsigned int lanesMask(ByteLanes a) 
+{
+    return (unsigned int)_mm256_movemask_epi8(a);
+}
+
+inline int lanesSum(ByteLanes a) 
+{
+    alignas(32) long long parts[4];
+    _mm256_store_si256((__m256i*)parts, _mm256_sad_epu8(a, _mm256_setzero_si256()));
+    return (int)(parts[0] + parts[1] + parts[2] + parts[3]);
+}
+#elif defined(SWIFTEX_SSE2)
+typedef __m128i ByteLanes;
+const int BYTE_LANES = 16;
+
+inline ByteLanes lanesLoad(const unsigned char* p) 
+{
+    return _mm_loadu_si128((const __m128i*)p);
+}
+
+inline ByteLanes lanesSplat(int v) 
+{
+    return _mm_set1_epi8((char)v);
+}
+
+inline ByteLanes lanesZero() 
+{
+    return _mm_setzero_si128();
+}
+
+inline ByteLanes lanesEqual(ByteLanes a, ByteLanes b) 
+{
+    return _mm_cmpeq_epi8(a, b);
+}
+
+inline ByteLanes lanesAnd(ByteLanes a, ByteLanes b) 
+{
+    return _mm_and_si128(a, b);
+}
+
+inline ByteLanes lanesSub(ByteLanes a, ByteLanes b) 
+{
+    return _mm_sub_epi8(a, b);
+}
+
+inline ByteLanes lanesOr(ByteLanes a, ByteLanes b) 
+{
+    return _mm_or_si128(a, b);
+}
+
+inline ByteLanes lanesAndNot(ByteLanes a, ByteLanes b) 
+{
+    return _mm_andnot_si128(a, b);
+}
+
+inline unsigned int lanesMask(ByteLanes a) 
+{
+    return (unsigned int)_mm_movemask_epi8(a);
+}
+
+inline int lanesSum(ByteLanes a) 
+{
+    __m128i sums = _mm_sad_epu8(a, _mm_setzero_si128());
+    return _mm_cvtsi128_si32(sums) + _mm_extract_epi16(sums, 4);
+}
+#endif
+
+// Writes to out (room for n entries) every slot below n whose status is
+// wanted and whose time is at or before limit, in slot order. Returns how
+// many were written.
+int selectDue(const unsigned char* status, const long long* time, int n, int wanted, long long limit, int* out) 
+{
+    int count = 0;
+    int i = 0;
+#if defined(SWIFTEX_AVX2) || defined(SWIFTEX_SSE2)
+    ByteLanes key = lanesSplat(wanted);
+    for (; i + BYTE_LANES <= n; i += BYTE_LANES) 
+    {
+        unsigned int mask = lanesMask(lanesEqual(lanesLoad(status + i), key));
+        if (!mask) 
+            continue;
+#if defined(SWIFTEX_AVX2)
+        // Four 64-bit deadlines per compare; drop the lanes still pending.
+        __m256i bound = _mm256_set1_epi64x(limit);
+        unsigned int late = 0;
+        for (int k = 0; k < BYTE_LANES; k += 4) 
+        {
+            __m256i t = _mm256_loadu_si256((const __m256i*)(time + i + k));
+            late |= (unsigned int)_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(t, bound))) << k;
+        }
+        mask &= ~late;
+        while (mask) 
+        {
+            out[count++] = i + lowestBit(mask);
+            mask &= mask - 1;
+        }
+#else
+        while (mask) 
+        {
+            int slot = i + lowestBit(mask);
+            mask &= mask - 1;
+            if (time[slot] <= limit) 
+                out[count++] = slot;
+        }
+#endif
+    }
+#endif
+    for (; i < n; i++) 
+        if (status[i] == wanted && time[i] <= limit) 
+            out[count++] = i;
+    return count;
+}
+
+// counts[s * zones + z] = number of slots below n with status s in zone z,
+// for every status below STATUS_COUNT and zone below zones.
+void countByStatusZone(const unsigned char* status, const unsigned char* zone, int n, int zones, int* counts) 
+{
+    for (int k = 0; k < STATUS_COUNT * zones; k++) 
+        counts[k] = 0;
+    int i = 0;
+#if defined(SWIFTEX_AVX2) || defined(SWIFTEX_SSE2)
+    // Byte-wide counters per status, flushed before any lane can pass 255.
+    // Each block is re-read once per zone while it is still in L1; lanes
+    // from other zones get their top bit set so no status key matches.
+    const int BLOCK = 255 * BYTE_LANES;
+    ByteLanes keys[STATUS_COUNT];
+    for (int s = 0; s < STATUS_COUNT; s++) 
+        keys[s] = lanesSplat(s);
+    int vectorEnd = n - n % BYTE_LANES;
+    for (int start = 0; start < vectorEnd; start += BLOCK) 
+    {
+        int end = min(start + BLOCK, vectorEnd);
+        for (int z = 0; z < zones; z++) 
+        {
+            ByteLanes zoneKey = lanesSplat(z);
+            ByteLanes outside = lanesSplat(0x80);
+            ByteLanes acc[STATUS_COUNT];
+            SWIFTEX_UNROLL
+            for (int s = 0; s < STATUS_COUNT; s++) 
+                acc[s] = lanesZero();
+            for (int j = start; j < end; j += BYTE_LANES) 
+            {
+                ByteLanes inZone = lanesEqual(lanesLoad(zone + j), zoneKey);
+                ByteLanes st = lanesOr(lanesLoad(status + j), lanesAndNot(inZone, outside));
+                SWIFTEX_UNROLL
+                for (int s = 0; s < STATUS_COUNT; s++) 
+                    acc[s] = lanesSub(acc[s], lanesEqual(st, keys[s]));
+            }
+            SWIFTEX_UNROLL
+            for (int s = 0; s < STATUS_COUNT; s++) 
+                counts[s * zones + z] += lanesSum(acc[s]);
+        }
+    }
+    i = vectorEnd;
+#endif
+    for (; i < n; i++) 
+        if (status[i] < STATUS_COUNT && zone[i] < zones) 
+            counts[status[i] * zones + zone[i]]++;
+}
+
+// Cold side of a parcel. The fields the lifecycle touches every tick live
+// in the owning engine's ParcelStore under slot and are reached through
+// the accessors below; the route is an id into the engine's RouteTable.
+struct Parcel 
+{
+    string id;
+    ParcelStore* store;
+    RouteTable* routes;
+    int slot;
+    int destCity;
+    double weight;
+    int priority; 
+    int priorityScore;
+    int heapIndex;
+    Parcel* queuePrev;
+    Parcel* queueNext;
+    string assignedRider;
+    int riderId;
+    
+    string weightCategory; 
+    
+    TrackingHistory history; 
+    
+    int routeId;
+    int currentRouteDistance;
+    int routeEntry;
+    unsigned int rerouteStamp;
+
+    ParcelObserver* observer;
+    bool indexed;
+    ParcelLink links[INDEX_KIND_COUNT];
+    ParcelLink activeLink;
+    int activeList;
+
+    // Write-ahead log bookkeeping: queued for the next commit, and how many
+    // history events are already on disk.
+    bool walDirty;
+    int walEvents;
+    
+    Parcel(ParcelStore& s, RouteTable& r) : store(&s), routes(&r), slot(s.allocate(this)), destCity(-1), weight(0), priority(1), priorityScore(0), heapIndex(-1), 
+               queuePrev(nullptr), queueNext(nullptr), riderId(-1), routeId(-1), 
+               currentRouteDistance(0), routeEntry(-1), rerouteStamp(0), 
+               observer(nullptr), indexed(false), activeList(-1), walDirty(false), walEvents(0) {}
+    
+    Parcel(ParcelStore& s, RouteTable& r, string pid, int dest, double w, int p, int z) : 
+           id(pid), store(&s), routes(&r), slot(s.allocate(this)), destCity(dest), weight(w), priority(p), 
+           heapIndex(-1), queuePrev(nullptr), queueNext(nullptr), riderId(-1), 
+           routeId(-1), currentRouteDistance(0), routeEntry(-1), rerouteStamp(0), 
+           observer(nullptr), indexed(false), activeList(-1), walDirty(false), walEvents(0) 
+    {
+        priorityScore = scoreFor(p, w); 
+        setStatus(STATUS_PICKUP_QUEUE);
+        setZone(z);
+
+        unsigned long long key = 14695981039346656037ULL;
+        for (char c : pid) 
+        {
+            key ^= (unsigned char)c;
+            key *= 1099511628211ULL;
+        }
+        rngKey() = key;
+        
+        if (w < 5.0) 
+            weightCategory = "Light";
+        else if (w < 20.0) 
+            weightCategory = "Medium";
+        else 
+            weightCategory = "Heavy";
+
+        history.addEvent(EV_PICKUP_CREATED);
+    }
+
+    Parcel(const Parcel&) = delete;
+    Parcel& operator=(const Parcel&) = delete;
+
+    int status() const 
+    {
+        return store->status[slot];
+    }
+
+    void setStatus(int s) 
+    {
+        store->status[slot] = (unsigned char)s;
+    }
+
+    int zoneId() const 
+    {
+        unsigned char z = store->zone[slot];
+        return z == ParcelStore::NO_ZONE ? -1 : z;
+    }
+
+    void setZone(int z) 
+    {
+        store->zone[slot] = (z < 0 || z >= ParcelStore::NO_ZONE) ? ParcelStore::NO_ZONE : (unsigned char)z;
+    }
+
+    long long& lastUpdateTime() 
+    {
+        return store->lastUpdateTime[slot];
+    }
+
+    long long lastUpdateTime() const 
+    {
+        return store->lastUpdateTime[slot];
+    }
+
+    long long& lastKnownTime() 
+    {
+        return store->lastKnownTime[slot];
+    }
+
+    long long lastKnownTime() const 
+    {
+        return store->lastKnownTime[slot];
+    }
+
+    long long& nextHopTime() 
+    {
+        return store->nextHopTime[slot];
+    }
+
+    long long nextHopTime() const 
+    {
+        return store->nextHopTime[slot];
+    }
+
+    long long& arrivalTime() 
+    {
+        return store->arrivalTime[slot];
+    }
+
+    long long arrivalTime() const 
+    {
+        return store->arrivalTime[slot];
+    }
+
+    long long& dispatchTime() 
+    {
+        return store->dispatchTime[slot];
+    }
+
+    long long dispatchTime() const 
+    {
+        return store->dispatchTime[slot];
+    }
+
+    int& currentPosition() 
+    {
+        return store->currentPosition[slot];
+    }
+
+    int currentPosition() const 
+    {
+        return store->currentPosition[slot];
+    }
+
+    int& deliveryAttempts() 
+    {
+        return store->deliveryAttempts[slot];
+    }
+
+    int deliveryAttempts() const 
+    {
+        return store->deliveryAttempts[slot];
+    }
+
+    unsigned long long& rngKey() 
+    {
+        return store->rngKey[slot];
+    }
+
+    unsigned long long rngKey() const 
+    {
+        return store->rngKey[slot];
+    }
+
+    unsigned int& rngDraws() 
+    {
+        return store->rngDraws[slot];
+    }
+
+    unsigned int rngDraws() const 
+    {
+        return store->rngDraws[slot];
+    }
+
+    bool hasRoute() const 
+    {
+        return routeId != -1;
+    }
+
+    const Route& route() const 
+    {
+        return routes->route(routeId);
+    }
+
+    // Starts p on the canonical copy of route at its first city; an empty
+    // route clears it.
+    void setRoute(const Route& route, int distance) 
+    {
+        int id = route.isEmpty() ? -1 : routes->acquire(route);
+        routes->release(routeId);
+        routeId = id;
+        currentRouteDistance = distance;
+        store->currentPosition[slot] = 0;
+        store->routeLength[slot] = route.size();
+    }
+    
+    void updateStatus(int newStatus, int event, int location) 
+    {
+        int oldStatus = status();
+        setStatus(newStatus);
+        long long now = nowMs();
+        lastUpdateTime() = now;
+        lastKnownTime() = now;
+        history.addEvent(event, location, now);
+        if (observer) 
+            observer->onStatusChanged(this, oldStatus);
+    }
+
+    void updateStatus(int newStatus, int event) 
+    {
+        updateStatus(newStatus, event, TRACKING_EVENTS[event].location);
+    }
+
+    void setRider(int rider, const string& label) 
+    {
+        int oldRider = riderId;
+        riderId = rider;
+        assignedRider = label;
+        if (observer) 
+            observer->onRiderChanged(this, oldRider);
+    }
+
+    // Priority first, then whole kilograms. Saturates instead of
+    // overflowing for huge or non-finite weights and priorities.
+    static int scoreFor(int priority, double weight) 
+    {
+        long long kg = 0;
+        if (weight >= 1e9) 
+            kg = 1000000000LL;
+        else if (weight > 0) 
+            kg = (long long)weight;
+        long long score = (long long)priority * 1000 + kg;
+        if (score > INT_MAX) 
+            return INT_MAX;
+        if (score < INT_MIN) 
+            return INT_MIN;
+        return (int)score;
+    }
+
+    string getStatusString() const 
+    {
+        return statusName(status());
+    }
+
+    static string statusName(int status) 
+    {
+        switch (status) 
+        {
+            case 0: return "Pickup Queue";
+            case 1: return "Warehouse (Sorted)";
+            case 2: return "Loading Vehicle";
+            case 3: return "In Transit";
+            case 4: return "Out for Delivery";
+            case 5: return "Delivered";
+            case 6: return "Returned to Sender";
+            case 7: return "MISSING";
+            case 8: return "Cancelled";
+            default: return "Unknown";
+        }
+    }
+    
+    ~Parcel() {
+        routes->release(routeId);
+        store->release(slot);
+    }
+};
+
+struct Rider {
+    string name;
+    string type;
+    int currentLoad;
+    int maxLoad;
+    bool available;
+    int parcelsAssigned;
+    
+    Rider(string n, string t, int max) : 
+          name(n), type(t), currentLoad(0), maxLoad(max), 
+          available(true), parcelsAssigned(0) {}
+};
+
+class StringQueue 
+{
+private:
+    struct Node 
+    { 
+        string data; 
+        Node* next; 
+        
+        Node(string d):data(d),next(nullptr){} 
+    };
+    
+    Node* front; 
+    Node* rear;
+    ObjectPool<Node> nodes;
+
+public:
+    StringQueue() : front(nullptr), rear(nullptr) {}
+
+    ~StringQueue() 
+    {
+        while (!isEmpty()) 
+            dequeue();
+    }
+    
+    void enqueue(string val) 
+    {
+        Node* n = nodes.create(val);
+        if(!rear) 
+            front = rear = n; 
+        else 
+        {
+            rear->next = n;
+            rear = n; 
+        }
+    }
+    
+    string dequeue() 
+    {
+        if(!front) 
+            return "";
+        
+        Node* temp = front; 
+        string val = front->data; 
+        front = front->next;
+        
+        if(!front) 
+            rear = nullptr; 
+        nodes.destroy(temp); 
+        return val;
+    }
+    
+    bool isEmpty() 
+    { 
+        return front == nullptr; 
+    }
+};
+
+class ParcelArrayList 
+{
+private:
+    Parcel** data; 
+    int capacity; 
+    int count;
+
+    void resize(int newCapacity) 
+    {
+        Parcel** newData = new Parcel*[newCapacity];
+        for (int i = 0; i < count; i++) 
+            newData[i] = data[i];
+        delete[] data; 
+        data = newData; 
+        capacity = newCapacity;
+    }
+
+public:
+    ParcelArrayList() : capacity(20), count(0) 
+    { 
+        data = new Parcel*[capacity]; 
+    }
+    
+    ~ParcelArrayList() 
+    {
+        delete[] data; 
+    }
+    
+    void add(Parcel* val) 
+    { 
+        if (count == capacity) 
+            resize(capacity * 2); 
+        data[count++] = val; 
+    }
+    
+    void removeLast() 
+    {
+        if (count > 0) count--; 
+    }
+    
+    Parcel* get(int index) const 
+    { 
+        return (index >= 0 && index < count) ? data[index] : nullptr; 
+    }
+    
+    void set(int index, Parcel* val) 
+    {
+        if (index >= 0 && index < count) 
+            data[index] = val; 
+    }
+    
+    int size() const 
+    {
+        return count; 
+    }
+    
+    bool isEmpty() const 
+    { 
+        return count == 0; 
+    }
+    
+    void clear() 
+    {
+        count = 0; 
+    }
+    
+    void swap(int i, int j) 
+    { 
+        Parcel* temp = data[i]; 
+        data[i] = data[j]; 
+        data[j] = temp; 
+    }
+};
+
+struct Edge 
+{ 
+    int dest; 
+    int weight; 
+    bool blocked; 
+    int currentLoad;
+    int maxLoad;
+    
+    Edge(int d=0, int w=0, int maxL=10) : 
+        dest(d), weight(w), blocked(false), currentLoad(0), maxLoad(maxL) {} 
+    
+    bool isOverloaded() {
+        return currentLoad >= maxLoad;
+    }
+};
+
+class EdgeArrayList 
+{
+private:
+    Edge* data; 
+    int capacity; 
+    int count;
+    
+    void resize(int newCapacity) 
+    {
+        Edge* newData = new Edge[newCapacity]; 
+        for(int i=0; i<count; i++) 
+            newData[i] = data[i];
+        
+        delete[] data; 
+        data = newData; 
+        capacity = newCapacity;
+    }
+
+public:
+    EdgeArrayList() : capacity(5), count(0) 
+    { 
+        data = new Edge[capacity]; 
+    }
+    
+    EdgeArrayList(const EdgeArrayList& other) 
+    {
+        capacity = other.capacity; 
+        count = other.count; 
+        data = new Edge[capacity];
+        
+        for(int i=0; i<count; i++) 
+            data[i] = other.data[i];
+    }
+    
+    EdgeArrayList& operator=(const EdgeArrayList& other) 
+    {
+        if(this != &other) 
+        {
+            delete[] data; 
+            capacity = other.capacity; 
+            count = other.count; 
+            data = new Edge[capacity];
+            
+            for(int i=0; i<count; i++) 
+                data[i] = other.data[i];
+        }
+        return *this;
+    }
+
+    ~EdgeArrayList() 
+    { 
+        delete[] data; 
+    }
+    
+    void add(Edge val) 
+    { 
+        if (count == capacity) 
+            resize(capacity * 2); 
+        data[count++] = val; 
+    }
+    
+    int size() const 
+    { 
+        return count; 
+    }
+    
+    Edge& getRef(int i) 
+    { 
+        return data[i]; 
+    }
+};
+
+class EdgeLookup 
+{
+private:
+    unsigned long long* keys;
+    int* values;
+    int slotMask;
+
+    static unsigned long long makeKey(int u, int v) 
+    {
+        return ((unsigned long long)(unsigned int)u << 32) | (unsigned int)v;
+    }
+
+    static unsigned int hashKey(unsigned long long key) 
+    {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        return (unsigned int)key;
+    }
+
+public:
+    EdgeLookup() : keys(nullptr), values(nullptr), slotMask(-1) {}
+
+    ~EdgeLookup() 
+    {
+        delete[] keys;
+        delete[] values;
+    }
+
+    void reset(int expected) 
+    {
+        int slotCount = 16;
+        while (slotCount < expected * 2) 
+            slotCount *= 2;
+        delete[] keys;
+        delete[] values;
+        keys = new unsigned long long[slotCount];
+        values = new int[slotCount];
+        slotMask = slotCount - 1;
+        for(int i=0; i<slotCount; i++) 
+            values[i] = -1;
+    }
+
+    // Returns the slot for (u,v); the slot is empty when its value is -1.
+    int& slot(int u, int v) 
+    {
+        unsigned long long key = makeKey(u, v);
+        int s = hashKey(key) & slotMask;
+        while (values[s] != -1 && keys[s] != key) 
+            s = (s + 1) & slotMask;
+        keys[s] = key;
+        return values[s];
+    }
+
+    int find(int u, int v) const 
+    {
+        if (slotMask < 0) 
+            return -1;
+        unsigned long long key = makeKey(u, v);
+        int s = hashKey(key) & slotMask;
+        while (values[s] != -1) 
+        {
+            if (keys[s] == key) 
+                return values[s];
+            s = (s + 1) & slotMask;
+        }
+        return -1;
+    }
+};
+
+struct CityNode 
+{ 
+    string name;
+    string zone; 
+    int zoneId;
+    
+    CityNode(string n="", string z="", int zid=-1) : name(n), zone(z), zoneId(zid) {} 
+};
+
+struct RoadSpec 
+{
+    int src;
+    int dest;
+    int weight;
+    int maxLoad;
+};
+
+struct EdgeState 
+{
+    bool blocked;
+    int currentLoad;
+
+    EdgeState() : blocked(false), currentLoad(0) {}
+};
+
+class DistanceHeap 
+{
+private:
+    struct Item 
+    { 
+        int dist; 
+        int node; 
+    };
+
+    Item* data;
+    int capacity;
+    int count;
+
+    void resize(int newCapacity) 
+    {
+        Item* newData = new Item[newCapacity];
+        for(int i=0; i<count; i++) 
+            newData[i] = data[i];
+        delete[] data;
+        data = newData;
+        capacity = newCapacity;
+    }
+
+public:
+    DistanceHeap() : capacity(32), count(0) 
+    { 
+        data = new Item[capacity]; 
+    }
+
+    ~DistanceHeap() 
+    { 
+        delete[] data; 
+    }
+
+    void push(int dist, int node) 
+    {
+        if (count == capacity) 
+            resize(capacity * 2 + 1);
+        int i = count++;
+        while (i > 0) 
+        {
+            int parent = (i - 1) / 2;
+            if (data[parent].dist <= dist) 
+                break;
+            data[i] = data[parent];
+            i = parent;
+        }
+        data[i].dist = dist;
+        data[i].node = node;
+    }
+
+    void pop(int& dist, int& node) 
+    {
+        dist = data[0].dist;
+        node = data[0].node;
+        Item last = data[--count];
+        int i = 0;
+        while (true) 
+        {
+            int child = 2 * i + 1;
+            if (child >= count) 
+                break;
+            if (child + 1 < count && data[child + 1].dist < data[child].dist) 
+                child++;
+            if (last.dist <= data[child].dist) 
+                break;
+            data[i] = data[child];
+            i = child;
+        }
+        if (count > 0) 
+            data[i] = last;
+    }
+
+    bool isEmpty() const 
+    { 
+        return count == 0; 
+    }
+
+    void clear() 
+    { 
+        count = 0; 
+    }
+};
+
+class PathCandidateList 
+{
+private:
+    Route* paths;
+    int* distances;
+    int capacity;
+    int count;
+
+    void resize(int newCapacity) 
+    {
+        Route* newPaths = new Route[newCapacity];
+        int* newDistances = new int[newCapacity];
+        for(int i=0; i<count; i++) 
+        {
+            newPaths[i] = move(paths[i]);
+            newDistances[i] = distances[i];
+        }
+        delete[] paths;
+        delete[] distances;
+        paths = newPaths;
+        distances = newDistances;
+        capacity = newCapacity;
+    }
+
+public:
+    PathCandidateList() : capacity(16), count(0) 
+    {
+        paths = new Route[capacity];
+        distances = new int[capacity];
+    }
+
+    ~PathCandidateList() 
+    {
+        delete[] paths;
+        delete[] distances;
+    }
+
+    void addUnique(Route&& path, int dist) 
+    {
+        for(int i=0; i<count; i++) 
+            if (paths[i].equals(path)) 
+                return;
+        if (count == capacity) 
+            resize(capacity * 2);
+        paths[count] = move(path);
+        distances[count] = dist;
+        count++;
+    }
+
+    int bestIndex() const 
+    {
+        int best = -1;
+        for(int i=0; i<count; i++) 
+        {
+            if (best == -1 || distances[i] < distances[best] || 
+                (distances[i] == distances[best] && paths[i].size() < paths[best].size())) 
+                best = i;
+        }
+        return best;
+    }
+
+    // Moves path i out; call removeAt(i) afterwards.
+    Route takePath(int i) 
+    { 
+        return move(paths[i]); 
+    }
+
+    int distanceAt(int i) const 
+    { 
+        return distances[i]; 
+    }
+
+    void removeAt(int i) 
+    {
+        count--;
+        if (i != count) 
+        {
+            paths[i] = move(paths[count]);
+            distances[i] = distances[count];
+        }
+    }
+
+    void clear() 
+    {
+        count = 0;
+    }
+};
+
+class RoadEventListener 
+{
+public:
+    virtual ~RoadEventListener() {}
+    virtual void onRoadBlocked(int edge) = 0;
+    virtual void onRoadUnblocked(int edge) = 0;
+    virtual void onRoadOverloaded(int edge) = 0;
+    virtual void onRoadCleared(int edge) = 0;
+};
+
+class MapGraph 
+{
+public:
+    CityNode* cities; 
+    int cityCount; 
+    int cityCapacity;
+    
+    // Frozen CSR layout: the out-edges of city u are edge ids
+    // edgeOffset[u] .. edgeOffset[u+1]-1. Static attributes live in the
+    // edgeDest/edgeWeight/edgeMaxLoad arrays, mutable ones in edgeState.
+    int* edgeOffset;
+    int* edgeDest;
+    int* edgeWeight;
+    int* edgeMaxLoad;
+    int* edgeTwin;
+    EdgeState* edgeState;
+    int edgeCount;
+    
+    static const int MAX_PATHS = 5;
+    Route availablePaths[MAX_PATHS]; 
+    int availablePathDistances[MAX_PATHS];
+    int pathCount;
+
+private:
+    NameIndex cityNames;
+    NameIndex zoneNames;
+    EdgeLookup edgeLookup;
+    RoadEventListener* listener;
+    int* overloadedRoads;
+    int* overloadedPos;
+    int overloadedCount;
+    RoadSpec* pendingEdges;
+    int* pendingEdgeId;
+    int pendingCount;
+    int pendingCapacity;
+    bool frozen;
+
+    // Scratch for findAllPaths, kept between calls so dispatching a
+    // parcel does not allocate.
+    int* searchDist;
+    int* searchParent;
+    bool* removedNode;
+    bool* bannedNext;
+    DistanceHeap searchHeap;
+    PathCandidateList candidates;
+    Route spurPath;
+
+    void addOverloaded(int road) 
+    {
+        overloadedPos[road] = overloadedCount;
+        overloadedRoads[overloadedCount++] = road;
+    }
+
+    void removeOverloaded(int road) 
+    {
+        int pos = overloadedPos[road];
+        int last = overloadedRoads[--overloadedCount];
+        overloadedRoads[pos] = last;
+        overloadedPos[last] = pos;
+        overloadedPos[road] = -1;
+    }
+
+    void growPending() 
+    {
+        int newCapacity = pendingCapacity * 2;
+        RoadSpec* newData = new RoadSpec[newCapacity];
+        for(int i=0; i<pendingCount; i++) 
+            newData[i] = pendingEdges[i];
+        delete[] pendingEdges;
+        pendingEdges = newData;
+        pendingCapacity = newCapacity;
+    }
+
+public:
+    MapGraph(int capacity = 200) : cityCount(0), cityCapacity(capacity), 
+        edgeDest(nullptr), edgeWeight(nullptr), edgeMaxLoad(nullptr), edgeTwin(nullptr), edgeState(nullptr), 
+        edgeCount(0), pathCount(0), listener(nullptr), overloadedRoads(nullptr), 
+        overloadedPos(nullptr), overloadedCount(0), pendingEdgeId(nullptr), pendingCount(0), 
+        pendingCapacity(64), frozen(false) 
+    { 
+        cities = new CityNode[cityCapacity]; 
+        edgeOffset = new int[1];
+        edgeOffset[0] = 0;
+        pendingEdges = new RoadSpec[pendingCapacity];
+        searchDist = new int[cityCapacity];
+        searchParent = new int[cityCapacity];
+        removedNode = new bool[cityCapacity];
+        bannedNext = new bool[cityCapacity];
+        for(int i=0; i<cityCapacity; i++) 
+        {
+            removedNode[i] = false;
+            bannedNext[i] = false;
+        }
+    }
+
+    ~MapGraph() 
+    {
+        delete[] cities;
+        delete[] edgeOffset;
+        delete[] edgeDest;
+        delete[] edgeWeight;
+        delete[] edgeMaxLoad;
+        delete[] edgeTwin;
+        delete[] edgeState;
+        delete[] pendingEdges;
+        delete[] pendingEdgeId;
+        delete[] overloadedRoads;
+        delete[] overloadedPos;
+        delete[] searchDist;
+        delete[] searchParent;
+        delete[] removedNode;
+        delete[] bannedNext;
+    }
+
+    int addCity(string name, string zone) 
+    { 
+        int existing = cityNames.find(name);
+        if (existing != -1) 
+            return existing;
+        if (cityCount == cityCapacity) 
+            return -1; 
+        cities[cityCount] = CityNode(name, zone, zoneNames.intern(zone)); 
+        cityNames.intern(name);
+        cityCount++;
+        if (frozen) 
+            freeze();
+        return cityCount - 1; 
+    }
+    
+    void addRoad(int u, int v, int dist, int maxLoad = 10) 
+    { 
+        if (pendingCount + 2 > pendingCapacity) 
+            growPending();
+        pendingEdges[pendingCount++] = {u, v, dist, maxLoad};
+        pendingEdges[pendingCount++] = {v, u, dist, maxLoad};
+        if (frozen) 
+            freeze();
+    }
+
+    // Builds the CSR arrays from the roads added so far. Edge state of
+    // roads that were already frozen is carried over to their new ids.
+    void freeze() 
+    {
+        int* newOffset = new int[cityCount + 1];
+        for(int i=0; i<=cityCount; i++) 
+            newOffset[i] = 0;
+        for(int i=0; i<pendingCount; i++) 
+            newOffset[pendingEdges[i].src + 1]++;
+        for(int i=0; i<cityCount; i++) 
+            newOffset[i + 1] += newOffset[i];
+
+        int* newDest = new int[pendingCount];
+        int* newWeight = new int[pendingCount];
+        int* newMaxLoad = new int[pendingCount];
+        EdgeState* newState = new EdgeState[pendingCount];
+        int* newEdgeId = new int[pendingCount];
+        int* fill = new int[cityCount];
+        for(int i=0; i<cityCount; i++) 
+            fill[i] = newOffset[i];
+
+        for(int i=0; i<pendingCount; i++) 
+        {
+            int e = fill[pendingEdges[i].src]++;
+            newDest[e] = pendingEdges[i].dest;
+            newWeight[e] = pendingEdges[i].weight;
+            newMaxLoad[e] = pendingEdges[i].maxLoad;
+            if (pendingEdgeId && i < edgeCount) 
+                newState[e] = edgeState[pendingEdgeId[i]];
+            newEdgeId[i] = e;
+        }
+        delete[] fill;
+
+        // addRoad always appends the two directions of a road as a pair.
+        int* newTwin = new int[pendingCount];
+        edgeLookup.reset(pendingCount);
+        for(int i=0; i<pendingCount; i++) 
+        {
+            int e = newEdgeId[i];
+            newTwin[e] = newEdgeId[i ^ 1];
+            int& known = edgeLookup.slot(pendingEdges[i].src, pendingEdges[i].dest);
+            if (known == -1 || newWeight[e] < newWeight[known]) 
+                known = e;
+        }
+
+        delete[] edgeOffset;
+        delete[] edgeDest;
+        delete[] edgeWeight;
+        delete[] edgeMaxLoad;
+        delete[] edgeTwin;
+        delete[] edgeState;
+        delete[] pendingEdgeId;
+        edgeOffset = newOffset;
+        edgeDest = newDest;
+        edgeWeight = newWeight;
+        edgeMaxLoad = newMaxLoad;
+        edgeTwin = newTwin;
+        edgeState = newState;
+        pendingEdgeId = newEdgeId;
+        edgeCount = pendingCount;
+        frozen = true;
+
+        delete[] overloadedRoads;
+        delete[] overloadedPos;
+        overloadedRoads = new int[edgeCount];
+        overloadedPos = new int[edgeCount];
+        overloadedCount = 0;
+        for(int e=0; e<edgeCount; e++) 
+        {
+            overloadedPos[e] = -1;
+            if (e == roadOf(e) && isOverloaded(e)) 
+                addOverloaded(e);
+        }
+    }
+
+    void setListener(RoadEventListener* l) 
+    {
+        listener = l;
+    }
+
+    // Both directions of a road share state; the lower edge id stands for the road.
+    int roadOf(int e) const 
+    {
+        return (edgeTwin[e] < e) ? edgeTwin[e] : e;
+    }
+
+    int findEdge(int u, int v) const 
+    {
+        return edgeLookup.find(u, v);
+    }
+
+    bool isOverloaded(int e) const 
+    {
+        return edgeState[e].currentLoad >= edgeMaxLoad[e];
+    }
+    
+    int getCityIndex(const string& name) const 
+    { 
+        return cityNames.find(name); 
+    }
+    
+    string getZone(const string& name) const 
+    {
+        int idx = getCityIndex(name);
+        if(idx != -1) 
+            return cities[idx].zone;
+
+        return "Unknown";
+    }
+
+    const string& cityName(int city) const 
+    {
+        return cities[city].name;
+    }
+
+    const string& zoneName(int zoneId) const 
+    {
+        return zoneNames.nameOf(zoneId);
+    }
+
+    int zoneIdOf(const string& zone) const 
+    {
+        return zoneNames.find(zone);
+    }
+
+    int zoneCount() const 
+    {
+        return zoneNames.size();
+    }
+
+    void displayAllCities() 
+    {
+        out() << "\n=========================================\n      AVAILABLE CITIES FOR DELIVERY\n=========================================\n";
+        out() << left << setw(25) << "CITY NAME" << setw(15) << "ZONE" << endl;
+        out() << "-----------------------------------------\n";
+        
+        for(int i=0; i<cityCount; i++) 
+        {
+            out() << left << setw(25) << cities[i].name << setw(15) << cities[i].zone << endl;
+        }
+        
+        out() << "\nTotal Cities: " << cityCount << endl;
+        out() << "=========================================\n";
+    }
+
+    void blockRandomRoad() 
+    {
+        if (cityCount < 2) 
+            return;
+        int u = rand() % cityCount;
+        int degree = edgeOffset[u + 1] - edgeOffset[u];
+        if (degree > 0) 
+            blockRoad(edgeOffset[u] + rand() % degree);
+    }
+
+    void blockRoad(int e) 
+    {
+        if (edgeState[e].blocked) 
+            return;
+        edgeState[e].blocked = true;
+        edgeState[edgeTwin[e]].blocked = true;
+        if (listener) 
+            listener->onRoadBlocked(roadOf(e));
+    }
+
+    void unblockRoad(int e) 
+    {
+        if (!edgeState[e].blocked) 
+            return;
+        edgeState[e].blocked = false;
+        edgeState[edgeTwin[e]].blocked = false;
+        if (listener) 
+            listener->onRoadUnblocked(roadOf(e));
+    }
+
+    int overloadedRoadCount() const 
+    {
+        return overloadedCount;
+    }
+
+    int overloadedRoad(int i) const 
+    {
+        return overloadedRoads[i];
+    }
+    
+    // Reports the roads currently over capacity; the set itself is kept
+    // up to date by adjustLoad, so this costs O(#overloaded roads).
+    int checkOverloads() {
+        for(int i=0; i<overloadedCount; i++) {
+            int e = overloadedRoads[i];
+            out() << ">>> Road " << cities[edgeDest[edgeTwin[e]]].name << " <-> " 
+                 << cities[edgeDest[e]].name << " at " << edgeState[e].currentLoad 
+                 << "/" << edgeMaxLoad[e] << " (closed until load drops)\n";
+        }
+        return overloadedCount;
+    }
+
+    void adjustLoad(int e, int delta) 
+    {
+        int road = roadOf(e);
+        bool wasOverloaded = isOverloaded(road);
+        edgeState[e].currentLoad += delta;
+        edgeState[edgeTwin[e]].currentLoad += delta;
+        bool nowOverloaded = isOverloaded(road);
+
+        if (nowOverloaded && !wasOverloaded) 
+        {
+            addOverloaded(road);
+            if (listener) 
+                listener->onRoadOverloaded(road);
+        }
+        else if (wasOverloaded && !nowOverloaded) 
+        {
+            removeOverloaded(road);
+            if (listener) 
+                listener->onRoadCleared(road);
+        }
+    }
+    
+    void displayNetwork() 
+    {
+        clearScreen();
+        out() << "\n=========================================\n      LOGISTICS NETWORK MAP VIEW\n=========================================\n";
+        for(int i=0; i<cityCount; i++) 
+        {
+            out() << " [" << cities[i].zone << "] " << left << setw(12) << cities[i].name << " connects to:\n";
+            
+            for(int e = edgeOffset[i]; e < edgeOffset[i + 1]; e++) 
+            {
+                EdgeState& s = edgeState[e];
+                out() << "    --> " << setw(12) << cities[edgeDest[e]].name << " | " << edgeWeight[e] << "km";
+                if(s.blocked) out() << " [BLOCKED]";
+                if(isOverloaded(e)) out() << " [OVERLOADED: " << s.currentLoad << "/" << edgeMaxLoad[e] << "]";
+                else if(s.currentLoad > 0) out() << " [Load: " << s.currentLoad << "/" << edgeMaxLoad[e] << "]";
+                out() << endl;
+            }
+            out() << "-----------------------------------------\n";
+        }
+    }
+
+    void findAllPaths(int start, int end) 
+    {
+        pathCount = 0;
+        if (start < 0 || end < 0 || start >= cityCount || end >= cityCount || cityCount > Route::MAX_CITIES) 
+            return;
+
+        for(int i=0; i<cityCount; i++) 
+        {
+            removedNode[i] = false;
+            bannedNext[i] = false;
+        }
+
+        int firstDist;
+        if (!shortestPath(start, end, availablePaths[0], firstDist)) 
+            return;
+        availablePathDistances[0] = firstDist;
+        pathCount = 1;
+
+        candidates.clear();
+        while (pathCount < MAX_PATHS) 
+        {
+            const Route& prev = availablePaths[pathCount - 1];
+            int rootDist = 0;
+
+            for(int i=0; i<prev.size()-1; i++) 
+            {
+                int spur = prev.get(i);
+
+                for(int k=0; k<pathCount; k++) 
+                {
+                    const Route& known = availablePaths[k];
+                    if (known.size() > i + 1 && samePrefix(known, prev, i + 1)) 
+                        bannedNext[known.get(i + 1)] = true;
+                }
+                for(int k=0; k<i; k++) 
+                    removedNode[prev.get(k)] = true;
+
+                int spurDist;
+                if (shortestPath(spur, end, spurPath, spurDist)) 
+                {
+                    Route total;
+                    for(int k=0; k<i; k++) 
+                        total.add(prev.get(k));
+                    for(int k=0; k<spurPath.size(); k++) 
+                        total.add(spurPath.get(k));
+                    candidates.addUnique(move(total), rootDist + spurDist);
+                }
+
+                for(int k=0; k<cityCount; k++) 
+                {
+                    removedNode[k] = false;
+                    bannedNext[k] = false;
+                }
+                rootDist += roadLength(spur, prev.get(i + 1));
+            }
+
+            int best = candidates.bestIndex();
+            if (best == -1) 
+                break;
+            availablePaths[pathCount] = candidates.takePath(best);
+            availablePathDistances[pathCount] = candidates.distanceAt(best);
+            candidates.removeAt(best);
+            pathCount++;
+        }
+    }
+
+    // Dijkstra from src to dst that skips removedNode cities and, on the
+    // first hop only, bannedNext cities.
+    bool shortestPath(int src, int dst, Route& path, int& pathDist) 
+    {
+        int* dist = searchDist;
+        int* parent = searchParent;
+        for(int i=0; i<cityCount; i++) 
+        {
+            dist[i] = INT_MAX;
+            parent[i] = -1;
+        }
+        dist[src] = 0;
+
+        DistanceHeap& pq = searchHeap;
+        pq.clear();
+        pq.push(0, src);
+        while (!pq.isEmpty()) 
+        {
+            int d, u;
+            pq.pop(d, u);
+            if (d > dist[u]) 
+                continue;
+            if (u == dst) 
+                break;
+
+            for(int e = edgeOffset[u]; e < edgeOffset[u + 1]; e++) 
+            {
+                int v = edgeDest[e];
+                if (edgeState[e].blocked || isOverloaded(e) || removedNode[v]) 
+                    continue;
+                if (u == src && bannedNext[v]) 
+                    continue;
+                if (d + edgeWeight[e] < dist[v]) 
+                {
+                    dist[v] = d + edgeWeight[e];
+                    parent[v] = u;
+                    pq.push(dist[v], v);
+                }
+            }
+        }
+
+        if (dist[dst] == INT_MAX) 
+            return false;
+
+        int hops = 0;
+        for(int v = dst; v != -1; v = parent[v]) 
+            hops++;
+        path.setSize(hops);
+        for(int v = dst; v != -1; v = parent[v]) 
+            path.set(--hops, v);
+
+        pathDist = dist[dst];
+        return true;
+    }
+
+    // Reverse shortest-path tree into dst over usable roads: dist[u] is the
+    // distance from u to dst and next[u] the city to drive to from u
+    // (-1 if dst is unreachable). Relaxes incoming roads, i.e. the twins
+    // of each popped city's outgoing edges, so one run serves every start.
+    void shortestPathTree(int dst, int dist[], int next[]) const 
+    {
+        for(int i=0; i<cityCount; i++) 
+        {
+            dist[i] = INT_MAX;
+            next[i] = -1;
+        }
+        dist[dst] = 0;
+
+        DistanceHeap pq;
+        pq.push(0, dst);
+        while (!pq.isEmpty()) 
+        {
+            int d, v;
+            pq.pop(d, v);
+            if (d > dist[v]) 
+                continue;
+
+            for(int e = edgeOffset[v]; e < edgeOffset[v + 1]; e++) 
+            {
+                int u = edgeDest[e];
+                int in = edgeTwin[e];
+                if (edgeState[in].blocked || isOverloaded(in)) 
+                    continue;
+                if (d + edgeWeight[in] < dist[u]) 
+                {
+                    dist[u] = d + edgeWeight[in];
+                    next[u] = v;
+                    pq.push(dist[u], u);
+                }
+            }
+        }
+    }
+
+    int roadLength(int u, int v) const 
+    {
+        int e = findEdge(u, v);
+        return (e == -1) ? INT_MAX : edgeWeight[e];
+    }
+
+    static bool samePrefix(const Route& a, const Route& b, int len) 
+    {
+        if (a.size() < len || b.size() < len) 
+            return false;
+        for(int i=0; i<len; i++) 
+            if (a.get(i) != b.get(i)) 
+                return false;
+        return true;
+    }
+    
+    int getMinRouteIndex() 
+    {
+        int minIdx = -1;
+        int minDist = INT_MAX;
+        for(int i=0; i<pathCount; i++) 
+        {
+            if(availablePathDistances[i] < minDist) 
+            {
+                minDist = availablePathDistances[i];
+                minIdx = i;
+            }
+        }
+        return minIdx;
+    }
+};
+
+void printParcelRow(ostream& os, const Parcel& p, const MapGraph& map) 
+{
+    os << left << setw(6) << p.id 
+       << setw(12) << map.cityName(p.destCity) 
+       << setw(8) << p.weightCategory
+       << setw(8) << map.zoneName(p.zoneId())
+       << " [" << p.getStatusString() << "]";
+}
+
+// Next time the lifecycle needs to look at a slot: departure for LOADING,
+// the next position report, arrival or signal timeout for IN_TRANSIT, and
+// the very next tick for a pending delivery attempt. LLONG_MAX means idle.
+long long lifecycleDeadline(const ParcelStore& s, int slot, long long currentTime) 
+{
+    int status = s.status[slot];
+    if (status == STATUS_LOADING) 
+        return s.lastUpdateTime[slot] + LOADING_MS;
+    if (status == STATUS_IN_TRANSIT) 
+        return min(min(s.nextHopTime[slot], s.arrivalTime[slot]), s.lastKnownTime[slot] + SIGNAL_TIMEOUT_MS + 1);
+    if (status == STATUS_DELIVERY_ATTEMPT) 
+        return currentTime + 1;
+    return LLONG_MAX;
+}
+
+// Fixed set of worker threads for data-parallel loops. parallelFor splits
+// [0, n) into one contiguous chunk per thread, runs the first chunk on the
+// calling thread and returns once every chunk has finished.
+class WorkerPool 
+{
+private:
+    static const int MIN_PARALLEL = 4096;
+
+    thread* workers;
+    int workerCount;
+    mutex lock;
+    condition_variable wake;
+    condition_variable done;
+    function<void(int, int)> job;
+    int jobSize;
+    int generation;
+    int pending;
+    bool stopping;
+
+    void chunk(int part, int& begin, int& end) const 
+    {
+        int parts = workerCount + 1;
+        begin = (int)((long long)jobSize * part / parts);
+        end = (int)((long long)jobSize * (part + 1) / parts);
+    }
+
+    void workerLoop(int part, int seen) 
+    {
+        unique_lock<mutex> guard(lock);
+        while (true) 
+        {
+            wake.wait(guard, [&] { return stopping || generation != seen; });
+            if (stopping) 
+                return;
+            seen = generation;
+            int begin, end;
+            chunk(part, begin, end);
+            guard.unlock();
+            if (begin < end) 
+                job(begin, end);
+            guard.lock();
+            if (--pending == 0) 
+                done.notify_one();
+        }
+    }
+
+public:
+    WorkerPool() : workers(nullptr), workerCount(0), jobSize(0), generation(0), pending(0), stopping(false) {}
+
+    ~WorkerPool() 
+    {
+        setThreads(1);
+    }
+
+    int threadCount() const 
+    {
+        return workerCount + 1;
+    }
+
+    void setThreads(int threads) 
+    {
+        if (workers) 
+        {
+            {
+                lock_guard<mutex> guard(lock);
+                stopping = true;
+            }
+            wake.notify_all();
+            for (int i = 0; i < workerCount; i++) 
+                workers[i].join();
+            delete[] workers;
+            workers = nullptr;
+            stopping = false;
+        }
+        workerCount = max(threads, 1) - 1;
+        if (workerCount > 0) 
+        {
+            workers = new thread[workerCount];
+            for (int i = 0; i < workerCount; i++) 
+                workers[i] = thread(&WorkerPool::workerLoop, this, i + 1, generation);
+        }
+    }
+
+    template <typename Fn> 
+    void parallelFor(int n, Fn fn) 
+    {
+        if (workerCount == 0 || n < MIN_PARALLEL) 
+        {
+            if (n > 0) 
+                fn(0, n);
+            return;
+        }
+        {
+            lock_guard<mutex> guard(lock);
+            job = fn;
+            jobSize = n;
+            pending = workerCount;
+            generation++;
+        }
+        wake.notify_all();
+        int begin, end;
+        chunk(0, begin, end);
+        fn(begin, end);
+        unique_lock<mutex> guard(lock);
+        done.wait(guard, [&] { return pending == 0; });
+        job = nullptr;
+    }
+};
+
+enum LifecycleEvent 
+{
+    LC_NONE,
+    LC_SIGNAL_TIMEOUT,
+    LC_DEPARTED,
+    LC_SIGNAL_LOST,
+    LC_ARRIVED,
+    LC_DELIVERED,
+    LC_RETURNED,
+    LC_RETRY
+};
+
+struct LifecycleTransition 
+{
+    int status;
+    int event;
+};
+
+// Indexed by LifecycleEvent.
+const LifecycleTransition LIFECYCLE_TRANSITIONS[] = 
+{
+    {-1, -1},
+    {STATUS_MISSING, EV_SIGNAL_TIMEOUT},
+    {STATUS_IN_TRANSIT, EV_DEPARTED},
+    {STATUS_MISSING, EV_SIGNAL_LOST},
+    {STATUS_DELIVERY_ATTEMPT, EV_ARRIVED_HUB},
+    {STATUS_DELIVERED, EV_DELIVERED},
+    {STATUS_RETURNED, EV_MAX_ATTEMPTS},
+    {STATUS_IN_TRANSIT, EV_RETRY}
+};
+
+// First half of a lifecycle step. Reads and writes only the slot's own
+// columns, so it is safe to run for many slots in parallel; the status
+// change it decides on is returned and applied later by applyLifecycle.
+int planLifecycle(ParcelStore& s, int slot, long long currentTime) 
+{
+    int status = s.status[slot];
+    if (status == STATUS_IN_TRANSIT && (currentTime - s.lastKnownTime[slot]) > SIGNAL_TIMEOUT_MS) 
+        return LC_SIGNAL_TIMEOUT;
+    
+    if (status == STATUS_LOADING) 
+    {
+        if (currentTime >= s.lastUpdateTime[slot] + LOADING_MS) 
+        {
+            s.nextHopTime[slot] = currentTime + HOP_INTERVAL_MS;
+            return LC_DEPARTED;
+        }
+    }
+    else if (status == STATUS_IN_TRANSIT) 
+    {
+        // The vehicle reports in once per hop interval and moves one
+        // city along its route with each report.
+        long long nextHop = s.nextHopTime[slot];
+        if (currentTime >= nextHop) 
+        {
+            long long reports = (currentTime - nextHop) / HOP_INTERVAL_MS + 1;
+            if (s.routeLength[slot] > 0) 
+            {
+                long long left = s.routeLength[slot] - 1 - s.currentPosition[slot];
+                s.currentPosition[slot] += (int)min(reports, left);
+            }
+            s.lastKnownTime[slot] = nextHop + (reports - 1) * HOP_INTERVAL_MS;
+            s.nextHopTime[slot] = nextHop + reports * HOP_INTERVAL_MS;
+
+            if (s.nextRandom(slot) % 1000 == 0) 
+                return LC_SIGNAL_LOST;
+        }
+        
+        if (currentTime >= s.arrivalTime[slot]) 
+            return LC_ARRIVED;
+    }
+    else if (status == STATUS_DELIVERY_ATTEMPT) 
+    {
+        if (s.nextRandom(slot) % 10 < 8) 
+            return LC_DELIVERED;
+        if (++s.deliveryAttempts[slot] >= 3) 
+            return LC_RETURNED;
+        s.arrivalTime[slot] = currentTime + RETRY_DELAY_MS; 
+        s.nextHopTime[slot] = currentTime + HOP_INTERVAL_MS;
+        return LC_RETRY;
+    }
+    return LC_NONE;
+}
+
+void applyLifecycle(Parcel* p, int event, const MapGraph& map) 
+{
+    if (event == LC_NONE) 
+        return;
+    const LifecycleTransition& t = LIFECYCLE_TRANSITIONS[event];
+    if (t.event == EV_ARRIVED_HUB) 
+        p->updateStatus(t.status, t.event, locations.intern(map.cityName(p->destCity)));
+    else 
+        p->updateStatus(t.status, t.event);
+    if (event == LC_SIGNAL_TIMEOUT) 
+        out() << ">>> ALERT: Parcel " << p->id << " marked as MISSING!\n";
+}
+
+// Runs one lifecycle step for a batch of parcels: planning is spread over
+// the worker pool, then the status changes (observer callbacks, history and
+// console output) are applied on the calling thread in batch order. Since
+// every random draw comes from the parcel's own stream, the outcome is the
+// same for any thread count.
+class LifecycleStepper 
+{
+private:
+    WorkerPool pool;
+    int* plan;
+    int planCapacity;
+
+public:
+    LifecycleStepper() : plan(new int[256]), planCapacity(256) {}
+
+    ~LifecycleStepper() 
+    {
+        delete[] plan;
+    }
+
+    WorkerPool& workers() 
+    {
+        return pool;
+    }
+
+    void setThreads(int threads) 
+    {
+        pool.setThreads(threads);
+    }
+
+    int threadCount() const 
+    {
+        return pool.threadCount();
+    }
+
+    // due holds slots of store.
+    void step(ParcelStore& store, const IntArrayList& due, long long currentTime, const MapGraph& map) 
+    {
+        int n = due.size();
+        if (n > planCapacity) 
+        {
+            delete[] plan;
+            while (planCapacity < n) 
+                planCapacity *= 2;
+            plan = new int[planCapacity];
+        }
+        int* events = plan;
+        pool.parallelFor(n, [&due, &store, events, currentTime](int begin, int end) {
+            for (int i = begin; i < end; i++) 
+                events[i] = planLifecycle(store, due.get(i), currentTime);
+        });
+        for (int i = 0; i < n; i++) 
+            applyLifecycle(store.owner[due.get(i)], events[i], map);
+    }
+};
+
+// Dispatched parcels that are still moving, kept on one intrusive list per
+// active state. A parcel leaves as soon as it reaches a terminal status, so
+// the hot loops never see delivered, returned or missing parcels.
+class ParcelLinkedList 
+{
+private:
+    static const int ACTIVE_FIRST = STATUS_LOADING;
+    static const int ACTIVE_COUNT = STATUS_DELIVERY_ATTEMPT - STATUS_LOADING + 1;
+
+    Parcel* head[ACTIVE_COUNT];
+    Parcel* tail[ACTIVE_COUNT];
+    int counts[ACTIVE_COUNT];
+
+    static int listOf(int status) 
+    {
+        int list = status - ACTIVE_FIRST;
+        return (list >= 0 && list < ACTIVE_COUNT) ? list : -1;
+    }
+
+    void link(Parcel* p, int list) 
+    {
+        p->activeList = list;
+        p->activeLink.prev = tail[list];
+        p->activeLink.next = nullptr;
+        if (tail[list]) 
+            tail[list]->activeLink.next = p;
+        else 
+            head[list] = p;
+        tail[list] = p;
+        counts[list]++;
+    }
+
+    void unlink(Parcel* p) 
+    {
+        int list = p->activeList;
+        if (p->activeLink.prev) 
+            p->activeLink.prev->activeLink.next = p->activeLink.next;
+        else 
+            head[list] = p->activeLink.next;
+        if (p->activeLink.next) 
+            p->activeLink.next->activeLink.prev = p->activeLink.prev;
+        else 
+            tail[list] = p->activeLink.prev;
+        p->activeLink.prev = p->activeLink.next = nullptr;
+        p->activeList = -1;
+        counts[list]--;
+    }
+    
+public:
+    ParcelLinkedList() 
+    {
+        for (int i = 0; i < ACTIVE_COUNT; i++) 
+        {
+            head[i] = tail[i] = nullptr;
+            counts[i] = 0;
+        }
+    }
+
+    // Files p under its current status; call again after every status
+    // change. Inactive statuses drop it from the list in O(1).
+    void track(Parcel* p) 
+    {
+        int list = listOf(p->status());
+        if (list == p->activeList) 
+            return;
+        if (p->activeList >= 0) 
+            unlink(p);
+        if (list >= 0) 
+            link(p, list);
+    }
+
+    void forget(Parcel* p) 
+    {
+        if (p->activeList >= 0) 
+            unlink(p);
+    }
+
+    int count(int status) const 
+    {
+        int list = listOf(status);
+        return list >= 0 ? counts[list] : 0;
+    }
+
+    int activeCount() const 
+    {
+        int total = 0;
+        for (int i = 0; i < ACTIVE_COUNT; i++) 
+            total += counts[i];
+        return total;
+    }
+
+    Parcel* first(int status) const 
+    {
+        int list = listOf(status);
+        return list >= 0 ? head[list] : nullptr;
+    }
+
+    static Parcel* next(const Parcel* p) 
+    {
+        return p->activeLink.next;
+    }
+    
+    void showTransitStatus(long long currentTime, const MapGraph& map) 
+    {
+        const int shown[] = {STATUS_LOADING, STATUS_IN_TRANSIT};
+        bool headerPrinted = false;
+        for (int s = 0; s < 2; s++) 
+        {
+            for (Parcel* p = first(shown[s]); p; p = next(p)) 
+            {
+                if (!headerPrinted) 
+                { 
+                    out() << "\n--- [LIVE TRANSIT MONITOR] ---\n"; 
+                    headerPrinted = true; 
+                }
+                
+                long long total = p->arrivalTime() - p->dispatchTime();
+                long long elapsed = currentTime - p->dispatchTime();
+                
+                string state = (p->status() == STATUS_LOADING) ? "[LOADING] " : "[MOVING]  ";
+                
+                if(total<=0) total=1;
+                double pct = (double)elapsed/total;
+                if(pct>1.0) pct=1.0;
+                
+                out() << state << p->id << " -> " << map.cityName(p->destCity) << ": [";
+                int bars = (int)(pct * 20);
+                for(int i=0; i<20; i++) out() << (i < bars ? "=" : " ");
+                out() << "] " << (int)(pct * 100) << "%";
+                
+                if (p->hasRoute() && p->currentPosition() > 0) {
+                    out() << " (At position " << p->currentPosition() << "/" 
+                         << p->route().size() << ")";
+                }
+                out() << "\n";
+            }
+        }
+        
+        if (!headerPrinted) 
+            out() << "\n(No parcels active in transit)\n";
+    }
+};
+
+// Reverse index from roads to the parcels that still have to drive them.
+// Every remaining hop of an active route is one entry, linked into its
+// road's list and into the parcel's own chain (in route order), and holds
+// one unit of load on that road. Advancing a parcel drops the hops behind
+// it, so road load always equals the number of parcels still to cross.
+class RouteOccupancy 
+{
+private:
+    struct Entry 
+    {
+        Parcel* parcel;
+        int edge;
+        int hop;
+        int roadPrev;
+        int roadNext;
+        int parcelNext;
+    };
+
+    Entry* entries;
+    int capacity;
+    int used;
+    int freeHead;
+    int* roadHead;
+    int* roadCount;
+    int roadSlots;
+
+    int allocate() 
+    {
+        if (freeHead != -1) 
+        {
+            int id = freeHead;
+            freeHead = entries[id].parcelNext;
+            return id;
+        }
+        if (used == capacity) 
+        {
+            Entry* grown = new Entry[capacity * 2];
+            for (int i = 0; i < used; i++) 
+                grown[i] = entries[i];
+            delete[] entries;
+            entries = grown;
+            capacity *= 2;
+        }
+        return used++;
+    }
+
+    // Unlinks the first hop of p's chain and gives back its load.
+    void dropFirst(Parcel* p, MapGraph& map) 
+    {
+        int id = p->routeEntry;
+        Entry& en = entries[id];
+        int road = map.roadOf(en.edge);
+        if (en.roadPrev != -1) 
+            entries[en.roadPrev].roadNext = en.roadNext;
+        else 
+            roadHead[road] = en.roadNext;
+        if (en.roadNext != -1) 
+            entries[en.roadNext].roadPrev = en.roadPrev;
+        roadCount[road]--;
+        p->routeEntry = en.parcelNext;
+        en.parcelNext = freeHead;
+        freeHead = id;
+        map.adjustLoad(en.edge, -1);
+    }
+
+public:
+    RouteOccupancy() : capacity(256), used(0), freeHead(-1), roadHead(nullptr), roadCount(nullptr), roadSlots(0) 
+    {
+        entries = new Entry[capacity];
+    }
+
+    ~RouteOccupancy() 
+    {
+        delete[] entries;
+        delete[] roadHead;
+        delete[] roadCount;
+    }
+
+    void init(int edgeCount) 
+    {
+        delete[] roadHead;
+        delete[] roadCount;
+        roadSlots = edgeCount;
+        roadHead = new int[roadSlots];
+        roadCount = new int[roadSlots];
+        for (int i = 0; i < roadSlots; i++) 
+        {
+            roadHead[i] = -1;
+            roadCount[i] = 0;
+        }
+    }
+
+    // Registers every hop of p's route from its current position onwards.
+    void attach(Parcel* p, MapGraph& map) 
+    {
+        release(p, map);
+        if (!p->hasRoute()) 
+            return;
+        int* tail = &p->routeEntry;
+        const Route& route = p->route();
+        for (int i = p->currentPosition(); i < route.size() - 1; i++) 
+        {
+            int e = map.findEdge(route.get(i), route.get(i + 1));
+            if (e == -1) 
+                continue;
+            int road = map.roadOf(e);
+            int id = allocate();
+            Entry& en = entries[id];
+            en.parcel = p;
+            en.edge = e;
+            en.hop = i;
+            en.roadPrev = -1;
+            en.roadNext = roadHead[road];
+            en.parcelNext = -1;
+            if (roadHead[road] != -1) 
+                entries[roadHead[road]].roadPrev = id;
+            roadHead[road] = id;
+            roadCount[road]++;
+            *tail = id;
+            tail = &en.parcelNext;
+            map.adjustLoad(e, 1);
+        }
+    }
+
+    // Drops the hops p has already driven.
+    void advance(Parcel* p, MapGraph& map) 
+    {
+        while (p->routeEntry != -1 && entries[p->routeEntry].hop < p->currentPosition()) 
+            dropFirst(p, map);
+    }
+
+    void release(Parcel* p, MapGraph& map) 
+    {
+        while (p->routeEntry != -1) 
+            dropFirst(p, map);
+    }
+
+    int parcelsOn(int road) const 
+    {
+        return roadCount[road];
+    }
+
+    // Appends up to limit of the parcels still due to cross road, newest
+    // attachment first, skipping any already carrying this stamp (those
+    // leave the road anyway and count towards the limit).
+    void collect(int road, int limit, unsigned int stamp, ParcelArrayList& out) const 
+    {
+        for (int id = roadHead[road]; id != -1 && limit > 0; id = entries[id].roadNext, limit--) 
+        {
+            Parcel* p = entries[id].parcel;
+            if (p->rerouteStamp != stamp) 
+            {
+                p->rerouteStamp = stamp;
+                out.add(p);
+            }
+        }
+    }
+};
+
+// Reroutes a batch of parcels at once. Parcels are grouped by destination
+// and each destination gets one reverse shortest-path tree (built on the
+// worker pool), from which every parcel in the group reads its new route
+// from its current city.
+class BatchRerouter 
+{
+private:
+    ParcelArrayList groups;
+    int* groupStart;
+    int groupCapacity;
+    int* treeDist;
+    int* treeNext;
+    int treeCapacity;
+
+    static bool sameRemaining(const Parcel* p, const int* next, int start) 
+    {
+        const Route& route = p->route();
+        int c = start;
+        for (int i = p->currentPosition(); i < route.size(); i++, c = next[c]) 
+            if (c == -1 || route.get(i) != c) 
+                return false;
+        return c == -1;
+    }
+
+public:
+    BatchRerouter() : groupStart(nullptr), groupCapacity(0), treeDist(nullptr), treeNext(nullptr), treeCapacity(0) {}
+
+    ~BatchRerouter() 
+    {
+        delete[] groupStart;
+        delete[] treeDist;
+        delete[] treeNext;
+    }
+
+    // Returns how many parcels actually got a different route.
+    int reroute(const ParcelArrayList& batch, MapGraph& map, WorkerPool& pool, RouteOccupancy& occupancy) 
+    {
+        int cities = map.cityCount;
+        if (groupCapacity < cities + 1) 
+        {
+            delete[] groupStart;
+            groupCapacity = cities + 1;
+            groupStart = new int[groupCapacity];
+        }
+
+        // Counting sort by destination; keeps batch order within a group.
+        for (int c = 0; c <= cities; c++) 
+            groupStart[c] = 0;
+        int affected = 0;
+        for (int k = 0; k < batch.size(); k++) 
+        {
+            Parcel* p = batch.get(k);
+            if (p && p->hasRoute()) 
+            {
+                groupStart[p->destCity + 1]++;
+                affected++;
+            }
+        }
+        if (affected == 0) 
+            return 0;
+
+        // Only destinations that actually have parcels get a tree; tree[c]
+        // is the slot of destination c in the tree buffers.
+        int* tree = new int[cities];
+        int* fill = new int[cities];
+        int trees = 0;
+        for (int c = 0; c < cities; c++) 
+            tree[c] = (groupStart[c + 1] > 0) ? trees++ : -1;
+        for (int c = 0; c < cities; c++) 
+            groupStart[c + 1] += groupStart[c];
+        for (int c = 0; c < cities; c++) 
+            fill[c] = groupStart[c];
+
+        groups.clear();
+        for (int k = 0; k < affected; k++) 
+            groups.add(nullptr);
+        for (int k = 0; k < batch.size(); k++) 
+        {
+            Parcel* p = batch.get(k);
+            if (p && p->hasRoute()) 
+                groups.set(fill[p->destCity]++, p);
+        }
+
+        if (treeCapacity < trees * cities) 
+        {
+            delete[] treeDist;
+            delete[] treeNext;
+            treeCapacity = trees * cities;
+            treeDist = new int[treeCapacity];
+            treeNext = new int[treeCapacity];
+        }
+        int* dists = treeDist;
+        int* nexts = treeNext;
+        const MapGraph& graph = map;
+        pool.parallelFor(cities, [&graph, tree, dists, nexts, cities](int begin, int end) {
+            for (int dst = begin; dst < end; dst++) 
+                if (tree[dst] >= 0) 
+                    graph.shortestPathTree(dst, dists + tree[dst] * cities, nexts + tree[dst] * cities);
+        });
+
+        int changed = 0;
+        for (int k = 0; k < affected; k++) 
+        {
+            Parcel* p = groups.get(k);
+            const int* dist = treeDist + tree[p->destCity] * cities;
+            const int* next = treeNext + tree[p->destCity] * cities;
+            int start = p->route().get(p->currentPosition());
+            if (dist[start] == INT_MAX || sameRemaining(p, next, start)) 
+                continue;
+
+            Route route;
+            for (int c = start; c != -1; c = next[c]) 
+                route.add(c);
+            occupancy.release(p, map);
+            p->setRoute(route, dist[start]);
+            occupancy.attach(p, map);
+            p->history.addEvent(EV_REROUTED);
+            out() << ">>> Route recalculated for parcel " << p->id << endl;
+            changed++;
+        }
+        delete[] tree;
+        delete[] fill;
+        return changed;
+    }
+};
+
+enum QueueMode 
+{
+    QUEUE_HEAP,
+    QUEUE_BUCKET
+};
+
+// Warehouse queue with two interchangeable layouts.
+//  QUEUE_HEAP:   addressable 4-ary max-heap, heapIndex is the heap slot.
+//  QUEUE_BUCKET: one FIFO list per priorityScore plus an occupancy bitmap,
+//                heapIndex is the bucket. Insert is O(1), extract-max only
+//                scans bitmap words, and equal scores leave in arrival order.
+//                Scores at or above MAX_BUCKET share the top bucket (FIFO),
+//                so the bucket arrays stay bounded whatever the weight.
+// Either way a parcel can be removed or re-prioritised without a search.
+class ParcelHeap 
+{
+private:
+    static const int ARITY = 4;
+    static const int MAX_BUCKET = (1 << 16) - 1;
+    QueueMode mode;
+    ParcelArrayList heap;
+
+    Parcel** bucketHead;
+    Parcel** bucketTail;
+    unsigned long long* occupied;
+    int bucketCount;
+    int topWord;
+    int queued;
+
+    void place(int index, Parcel* p) 
+    {
+        heap.set(index, p);
+        p->heapIndex = index;
+    }
+    
+    void heapifyUp(int index) 
+    {
+        Parcel* moving = heap.get(index);
+        while (index > 0) 
+        {
+            int parent = (index - 1) / ARITY;
+            Parcel* above = heap.get(parent);
+            if (moving->priorityScore <= above->priorityScore) 
+                break;
+            place(index, above);
+            index = parent;
+        }
+        place(index, moving);
+    }
+    
+    void heapifyDown(int index) 
+    {
+        Parcel* moving = heap.get(index);
+        int n = heap.size();
+        while (true) 
+        {
+            int first = ARITY * index + 1;
+            if (first >= n) 
+                break;
+            int largest = first;
+            int last = (first + ARITY < n) ? first + ARITY : n;
+            for (int c = first + 1; c < last; c++) 
+                if (heap.get(c)->priorityScore > heap.get(largest)->priorityScore) 
+                    largest = c;
+            if (heap.get(largest)->priorityScore <= moving->priorityScore) 
+                break;
+            place(index, heap.get(largest));
+            index = largest;
+        }
+        place(index, moving);
+    }
+
+    void removeAt(int index) 
+    {
+        Parcel* removed = heap.get(index);
+        Parcel* last = heap.get(heap.size() - 1);
+        heap.removeLast();
+        removed->heapIndex = -1;
+        if (index < heap.size()) 
+        {
+            place(index, last);
+            if (index > 0 && last->priorityScore > heap.get((index - 1) / ARITY)->priorityScore) 
+                heapifyUp(index);
+            else 
+                heapifyDown(index);
+        }
+    }
+
+    void growBuckets(int key) 
+    {
+        int newCount = (bucketCount == 0) ? 4096 : bucketCount;
+        while (newCount <= key) 
+            newCount *= 2;
+        Parcel** newHead = new Parcel*[newCount];
+        Parcel** newTail = new Parcel*[newCount];
+        unsigned long long* newBits = new unsigned long long[newCount / 64];
+        for (int i = 0; i < newCount; i++) 
+        {
+            newHead[i] = (i < bucketCount) ? bucketHead[i] : nullptr;
+            newTail[i] = (i < bucketCount) ? bucketTail[i] : nullptr;
+        }
+        for (int w = 0; w < newCount / 64; w++) 
+            newBits[w] = (w < bucketCount / 64) ? occupied[w] : 0;
+        delete[] bucketHead;
+        delete[] bucketTail;
+        delete[] occupied;
+        bucketHead = newHead;
+        bucketTail = newTail;
+        occupied = newBits;
+        bucketCount = newCount;
+    }
+
+    static int bucketKey(const Parcel* p) 
+    {
+        if (p->priorityScore < 0) 
+            return 0;
+        return (p->priorityScore > MAX_BUCKET) ? MAX_BUCKET : p->priorityScore;
+    }
+
+    void bucketPush(Parcel* p) 
+    {
+        int key = bucketKey(p);
+        if (key >= bucketCount) 
+            growBuckets(key);
+        p->queuePrev = bucketTail[key];
+        p->queueNext = nullptr;
+        if (bucketTail[key]) 
+            bucketTail[key]->queueNext = p;
+        else 
+        {
+            bucketHead[key] = p;
+            occupied[key / 64] |= 1ULL << (key % 64);
+            if (key / 64 > topWord) 
+                topWord = key / 64;
+        }
+        bucketTail[key] = p;
+        p->heapIndex = key;
+        queued++;
+    }
+
+    void bucketUnlink(Parcel* p) 
+    {
+        int key = p->heapIndex;
+        if (p->queuePrev) 
+            p->queuePrev->queueNext = p->queueNext;
+        else 
+            bucketHead[key] = p->queueNext;
+        if (p->queueNext) 
+            p->queueNext->queuePrev = p->queuePrev;
+        else 
+            bucketTail[key] = p->queuePrev;
+        if (!bucketHead[key]) 
+            occupied[key / 64] &= ~(1ULL << (key % 64));
+        p->queuePrev = p->queueNext = nullptr;
+        p->heapIndex = -1;
+        queued--;
+    }
+
+    Parcel* bucketPopMax() 
+    {
+        while (topWord >= 0 && occupied[topWord] == 0) 
+            topWord--;
+        if (topWord < 0) 
+            return nullptr;
+        int key = topWord * 64 + highestBit(occupied[topWord]);
+        Parcel* p = bucketHead[key];
+        bucketUnlink(p);
+        return p;
+    }
+
+public:
+    ParcelHeap(QueueMode m = QUEUE_BUCKET) : mode(m), bucketHead(nullptr), bucketTail(nullptr), 
+        occupied(nullptr), bucketCount(0), topWord(-1), queued(0) {}
+
+    ~ParcelHeap() 
+    {
+        delete[] bucketHead;
+        delete[] bucketTail;
+        delete[] occupied;
+    }
+
+    QueueMode getMode() const 
+    {
+        return mode;
+    }
+
+    void insert(Parcel* val) 
+    { 
+        if (contains(val)) 
+            return;
+        if (mode == QUEUE_BUCKET) 
+        {
+            bucketPush(val);
+            return;
+        }
+        heap.add(val); 
+        heapifyUp(heap.size() - 1); 
+    }
+    
+    // Adds a whole batch at once. In heap mode the batch is appended and
+    // the heap is rebuilt bottom-up, which is O(n) instead of O(n log n).
+    void bulkInsert(const ParcelArrayList& batch) 
+    {
+        if (mode == QUEUE_BUCKET) 
+        {
+            for (int i = 0; i < batch.size(); i++) 
+                if (!contains(batch.get(i))) 
+                    bucketPush(batch.get(i));
+            return;
+        }
+        for (int i = 0; i < batch.size(); i++) 
+        {
+            Parcel* p = batch.get(i);
+            if (contains(p)) 
+                continue;
+            heap.add(p);
+            p->heapIndex = heap.size() - 1;
+        }
+        for (int i = (heap.size() - 2) / ARITY; i >= 0; i--) 
+            heapifyDown(i);
+    }
+    
+    Parcel* extractMax() 
+    {
+        if (mode == QUEUE_BUCKET) 
+            return bucketPopMax();
+        if (heap.isEmpty()) 
+            return nullptr;
+        
+        Parcel* maxVal = heap.get(0);
+        removeAt(0);
+        return maxVal;
+    }
+
+    bool contains(const Parcel* p) const 
+    {
+        if (mode == QUEUE_BUCKET) 
+            return p->heapIndex >= 0 && p->heapIndex < bucketCount && 
+                   (bucketHead[p->heapIndex] == p || p->queuePrev != nullptr);
+        return p->heapIndex >= 0 && p->heapIndex < heap.size() && heap.get(p->heapIndex) == p;
+    }
+
+    bool remove(Parcel* p) 
+    {
+        if (!contains(p)) 
+            return false;
+        if (mode == QUEUE_BUCKET) 
+            bucketUnlink(p);
+        else 
+            removeAt(p->heapIndex);
+        return true;
+    }
+
+    bool changePriority(Parcel* p, int newScore) 
+    {
+        if (!contains(p)) 
+            return false;
+        int oldScore = p->priorityScore;
+        if (mode == QUEUE_BUCKET) 
+        {
+            if (newScore != oldScore) 
+            {
+                bucketUnlink(p);
+                p->priorityScore = newScore;
+                bucketPush(p);
+            }
+            return true;
+        }
+        p->priorityScore = newScore;
+        if (newScore > oldScore) 
+            heapifyUp(p->heapIndex);
+        else if (newScore < oldScore) 
+            heapifyDown(p->heapIndex);
+        return true;
+    }
+    
+    bool isEmpty() 
+    { 
+        return size() == 0; 
+    }
+    
+    int size() 
+    {
+        return (mode == QUEUE_BUCKET) ? queued : heap.size();
+    }
+};
+
+// Hierarchical timer wheel keyed on epoch milliseconds. Level L has 64
+// slots of 64^L ms; a timer sits at the lowest level whose window it shares
+// with the current time, so level 0 holds everything due in the current
+// 64 ms and each higher level is strictly later than the one below it.
+// Moving time forward re-files the slots whose window we enter. Schedule
+// and cancel are O(1), and a tick only touches timers that actually moved.
+class TimerWheel 
+{
+private:
+    static const int LEVELS = 7;
+    static const int BITS = 6;
+    static const int SLOTS = 1 << BITS;
+
+    // Per-parcel timer state, indexed by parcel slot; -1 ends a list.
+    long long* due;
+    int* level;
+    int* bucket;
+    int* prev;
+    int* next;
+    int capacity;
+
+    int slots[LEVELS][SLOTS];
+    unsigned long long occupied[LEVELS];
+    long long current;
+    int count;
+
+    static long long windowOf(long long t, int level) 
+    {
+        return t >> (BITS * level);
+    }
+
+    template <typename T> 
+    static void growColumn(T*& column, int oldCapacity, int newCapacity, T fill) 
+    {
+        T* grown = new T[newCapacity];
+        for (int i = 0; i < oldCapacity; i++) 
+            grown[i] = column[i];
+        for (int i = oldCapacity; i < newCapacity; i++) 
+            grown[i] = fill;
+        delete[] column;
+        column = grown;
+    }
+
+    void ensure(int id) 
+    {
+        if (id < capacity) 
+            return;
+        int newCapacity = capacity;
+        while (newCapacity <= id) 
+            newCapacity *= 2;
+        growColumn(due, capacity, newCapacity, 0LL);
+        growColumn(level, capacity, newCapacity, -1);
+        growColumn(bucket, capacity, newCapacity, -1);
+        growColumn(prev, capacity, newCapacity, -1);
+        growColumn(next, capacity, newCapacity, -1);
+        capacity = newCapacity;
+    }
+
+    void link(int id) 
+    {
+        int l = 0;
+        int b;
+        if (due[id] <= current) 
+            b = (int)(current & (SLOTS - 1));
+        else 
+        {
+            while (l < LEVELS - 1 && windowOf(due[id], l + 1) != windowOf(current, l + 1)) 
+                l++;
+            b = (int)(windowOf(due[id], l) & (SLOTS - 1));
+        }
+        level[id] = l;
+        bucket[id] = b;
+        prev[id] = -1;
+        next[id] = slots[l][b];
+        if (next[id] != -1) 
+            prev[next[id]] = id;
+        slots[l][b] = id;
+        occupied[l] |= 1ULL << b;
+    }
+
+    void unlink(int id) 
+    {
+        int l = level[id], b = bucket[id];
+        if (prev[id] != -1) 
+            next[prev[id]] = next[id];
+        else 
+            slots[l][b] = next[id];
+        if (next[id] != -1) 
+            prev[next[id]] = prev[id];
+        if (slots[l][b] == -1) 
+            occupied[l] &= ~(1ULL << b);
+        level[id] = -1;
+        prev[id] = next[id] = -1;
+    }
+
+    // Only valid when nothing is due before t.
+    void moveTo(long long t) 
+    {
+        if (t <= current) 
+            return;
+        long long old = current;
+        current = t;
+        for (int l = LEVELS - 1; l > 0; l--) 
+        {
+            if (windowOf(old, l) == windowOf(t, l)) 
+                continue;
+            int b = (int)(windowOf(t, l) & (SLOTS - 1));
+            int id = slots[l][b];
+            slots[l][b] = -1;
+            occupied[l] &= ~(1ULL << b);
+            while (id != -1) 
+            {
+                int following = next[id];
+                link(id);
+                id = following;
+            }
+        }
+    }
+
+public:
+    TimerWheel() : capacity(1024), current(0), count(0) 
+    {
+        due = new long long[capacity];
+        level = new int[capacity];
+        bucket = new int[capacity];
+        prev = new int[capacity];
+        next = new int[capacity];
+        for (int i = 0; i < capacity; i++) 
+        {
+            due[i] = 0;
+            level[i] = bucket[i] = prev[i] = next[i] = -1;
+        }
+        for (int l = 0; l < LEVELS; l++) 
+        {
+            occupied[l] = 0;
+            for (int b = 0; b < SLOTS; b++) 
+                slots[l][b] = -1;
+        }
+    }
+
+    ~TimerWheel() 
+    {
+        delete[] due;
+        delete[] level;
+        delete[] bucket;
+        delete[] prev;
+        delete[] next;
+    }
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    void start(long long now) 
+    {
+        if (count == 0) 
+            current = now;
+    }
+
+    void schedule(int id, long long when) 
+    {
+        ensure(id);
+        if (level[id] >= 0) 
+            unlink(id);
+        else 
+            count++;
+        due[id] = when;
+        link(id);
+    }
+
+    void cancel(int id) 
+    {
+        if (id >= capacity || level[id] < 0) 
+            return;
+        unlink(id);
+        count--;
+    }
+
+    bool isScheduled(int id) const 
+    {
+        return id < capacity && level[id] >= 0;
+    }
+
+    int size() const 
+    {
+        return count;
+    }
+
+    // Earliest due time of any timer, or LLONG_MAX if none are pending.
+    long long nextDue() const 
+    {
+        for (int l = 0; l < LEVELS; l++) 
+        {
+            if (!occupied[l]) 
+                continue;
+            int b = lowestBit(occupied[l]);
+            if (l == 0) 
+                return (current & ~(long long)(SLOTS - 1)) | b;
+            long long best = LLONG_MAX;
+            for (int id = slots[l][b]; id != -1; id = next[id]) 
+                if (due[id] < best) 
+                    best = due[id];
+            return best;
+        }
+        return LLONG_MAX;
+    }
+
+    // Advances the wheel to now and hands back the slot of every timer that
+    // came due, in due-time order. Expired timers are no longer scheduled.
+    void expire(long long now, IntArrayList& expired) 
+    {
+        while (true) 
+        {
+            long long when = nextDue();
+            if (when > now) 
+                break;
+            moveTo(when);
+            int b = (int)(current & (SLOTS - 1));
+            int id = slots[0][b];
+            slots[0][b] = -1;
+            occupied[0] &= ~(1ULL << b);
+            while (id != -1) 
+            {
+                int following = next[id];
+                level[id] = -1;
+                prev[id] = next[id] = -1;
+                expired.add(id);
+                count--;
+                id = following;
+            }
+        }
+        moveTo(now);
+    }
+};
+
+struct HashTableStats 
+{
+    int size;
+    int capacity;
+    int tombstones;
+    double loadFactor;
+    double avgProbeLength;
+    int maxProbeLength;
+};
+
+// Open-addressing parcel index in the style of a Swiss table. Slots are
+// grouped in 16s; each slot has a control byte that is EMPTY, DELETED or
+// the low 7 bits of the key hash, so a probe compares a whole group's tags
+// at once and only touches a Parcel when the tag matches. Slots point
+// straight at the parcel and the parcel id is the key.
+class ParcelHashTable 
+{
+private:
+    static const int GROUP = 16;
+    static const signed char CTRL_EMPTY = -128;
+    static const signed char CTRL_DELETED = -2;
+
+    signed char* ctrl;
+    Parcel** slots;
+    int capacity;
+    int groupMask;
+    int liveCount;
+    int tombstoneCount;
+    double maxLoadFactor;
+
+    static unsigned long long hashFunction(const string& key) 
+    {
+        unsigned long long hash = 5381;
+        for (char c : key) 
+            hash = ((hash << 5) + hash) + c;
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+        return hash;
+    }
+
+    static signed char tagOf(unsigned long long hash) 
+    {
+        return (signed char)(hash & 0x7f);
+    }
+
+    // Bit i is set when control byte i of the group equals tag.
+    unsigned int matchTag(int group, signed char tag) const 
+    {
+#ifdef SWIFTEX_SSE2
+        __m128i bytes = _mm_loadu_si128((const __m128i*)(ctrl + group * GROUP));
+        return (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(tag)));
+#else
+        unsigned int mask = 0;
+        const signed char* c = ctrl + group * GROUP;
+        for (int i = 0; i < GROUP; i++) 
+            if (c[i] == tag) 
+                mask |= 1u << i;
+        return mask;
+#endif
+    }
+
+    // Bit i is set when slot i of the group is EMPTY or DELETED.
+    unsigned int matchFree(int group) const 
+    {
+#ifdef SWIFTEX_SSE2
+        __m128i bytes = _mm_loadu_si128((const __m128i*)(ctrl + group * GROUP));
+        return (unsigned int)_mm_movemask_epi8(bytes);
+#else
+        unsigned int mask = 0;
+        const signed char* c = ctrl + group * GROUP;
+        for (int i = 0; i < GROUP; i++) 
+            if (c[i] < 0) 
+                mask |= 1u << i;
+        return mask;
+#endif
+    }
+
+    static int lowestBit(unsigned int mask) 
+    {
+        int i = 0;
+        while (!(mask & 1u)) 
+        {
+            mask >>= 1;
+            i++;
+        }
+        return i;
+    }
+
+    int findSlot(const string& key, int& probes) const 
+    {
+        unsigned long long hash = hashFunction(key);
+        signed char tag = tagOf(hash);
+        int group = (int)(hash >> 7) & groupMask;
+        probes = 0;
+        for (int step = 1; step <= groupMask + 1; step++) 
+        {
+            probes = step;
+            unsigned int hits = matchTag(group, tag);
+            while (hits) 
+            {
+                int slot = group * GROUP + lowestBit(hits);
+                if (slots[slot]->id == key) 
+                    return slot;
+                hits &= hits - 1;
+            }
+            if (matchTag(group, CTRL_EMPTY)) 
+                return -1;
+            group = (group + step) & groupMask;
+        }
+        return -1;
+    }
+
+    void place(Parcel* value, unsigned long long hash) 
+    {
+        int group = (int)(hash >> 7) & groupMask;
+        for (int step = 1; ; step++) 
+        {
+            unsigned int open = matchFree(group);
+            if (open) 
+            {
+                int slot = group * GROUP + lowestBit(open);
+                if (ctrl[slot] == CTRL_DELETED) 
+                    tombstoneCount--;
+                ctrl[slot] = tagOf(hash);
+                slots[slot] = value;
+                liveCount++;
+                return;
+            }
+            group = (group + step) & groupMask;
+        }
+    }
+
+    void allocate(int newCapacity) 
+    {
+        capacity = newCapacity;
+        groupMask = capacity / GROUP - 1;
+        ctrl = new signed char[capacity];
+        slots = new Parcel*[capacity];
+        for (int i = 0; i < capacity; i++) 
+        {
+            ctrl[i] = CTRL_EMPTY;
+            slots[i] = nullptr;
+        }
+        liveCount = 0;
+        tombstoneCount = 0;
+    }
+
+    void rehash(int newCapacity) 
+    {
+        signed char* oldCtrl = ctrl;
+        Parcel** oldSlots = slots;
+        int oldCapacity = capacity;
+        allocate(newCapacity);
+        for (int i = 0; i < oldCapacity; i++) 
+            if (oldCtrl[i] >= 0) 
+                place(oldSlots[i], hashFunction(oldSlots[i]->id));
+        delete[] oldCtrl;
+        delete[] oldSlots;
+    }
+
+    void eraseSlot(int slot) 
+    {
+        // A group that still has an EMPTY byte ends every probe chain
+        // reaching it, so the slot can go straight back to EMPTY.
+        if (matchTag(slot / GROUP, CTRL_EMPTY)) 
+            ctrl[slot] = CTRL_EMPTY;
+        else 
+        {
+            ctrl[slot] = CTRL_DELETED;
+            tombstoneCount++;
+        }
+        slots[slot] = nullptr;
+        liveCount--;
+    }
+
+    static int roundUpPow2(int n) 
+    {
+        int cap = GROUP;
+        while (cap < n) 
+            cap *= 2;
+        return cap;
+    }
+
+public:
+    ParcelHashTable(int cap = 1024, double loadFactor = 0.875) : maxLoadFactor(loadFactor) 
+    { 
+        allocate(roundUpPow2(cap));
+    }
+    
+    ~ParcelHashTable() 
+    {
+        delete[] ctrl; 
+        delete[] slots; 
+    }
+
+    void setMaxLoadFactor(double loadFactor) 
+    {
+        maxLoadFactor = loadFactor;
+        reserve(liveCount);
+    }
+
+    void reserve(int expected) 
+    {
+        int needed = roundUpPow2((int)(expected / maxLoadFactor) + 1);
+        if (needed > capacity) 
+            rehash(needed);
+    }
+    
+    void insert(Parcel* value) 
+    {
+        int probes;
+        int existing = findSlot(value->id, probes);
+        if (existing != -1) 
+        {
+            slots[existing] = value;
+            return;
+        }
+
+        if (liveCount + tombstoneCount + 1 > capacity * maxLoadFactor) 
+        {
+            // Mostly tombstones: clean up in place instead of growing.
+            if (liveCount + 1 <= capacity * maxLoadFactor / 2) 
+                rehash(capacity);
+            else 
+                rehash(capacity * 2);
+        }
+        place(value, hashFunction(value->id));
+    }
+    
+    Parcel* search(const string& key) const 
+    {
+        int probes;
+        int slot = findSlot(key, probes);
+        return (slot == -1) ? nullptr : slots[slot];
+    }
+
+    bool remove(const string& key) 
+    {
+        int probes;
+        int slot = findSlot(key, probes);
+        if (slot == -1) 
+            return false;
+        eraseSlot(slot);
+        return true;
+    }
+
+    int removeWhere(bool (*shouldRemove)(const Parcel*)) 
+    {
+        int removed = 0;
+        for (int i = 0; i < capacity; i++) 
+        {
+            if (ctrl[i] >= 0 && shouldRemove(slots[i])) 
+            {
+                eraseSlot(i);
+                removed++;
+            }
+        }
+        return removed;
+    }
+
+    int size() const 
+    {
+        return liveCount;
+    }
+
+    template <typename Fn> 
+    void forEach(Fn fn) const 
+    {
+        for (int i = 0; i < capacity; i++) 
+            if (ctrl[i] >= 0) 
+                fn(slots[i]);
+    }
+
+    HashTableStats stats() const 
+    {
+        HashTableStats s;
+        s.size = liveCount;
+        s.capacity = capacity;
+        s.tombstones = tombstoneCount;
+        s.loadFactor = (double)(liveCount + tombstoneCount) / capacity;
+        s.maxProbeLength = 0;
+        long long totalProbes = 0;
+        for (int i = 0; i < capacity; i++) 
+        {
+            if (ctrl[i] < 0) 
+                continue;
+            int probes;
+            findSlot(slots[i]->id, probes);
+            totalProbes += probes;
+            if (probes > s.maxProbeLength) 
+                s.maxProbeLength = probes;
+        }
+        s.avgProbeLength = liveCount ? (double)totalProbes / liveCount : 0.0;
+        return s;
+    }
+    
+    void printAll(const MapGraph& map) 
+    {
+        clearScreen();
+        out() << "\n=========================================\n           SYSTEM DATABASE\n=========================================\n";
+        out() << "ID     DEST         CAT     ZONE     STATUS\n";
+        for(int i=0; i<capacity; i++) 
+            if(ctrl[i] >= 0) 
+            {
+                printParcelRow(out(), *slots[i], map);
+                out() << endl;
+            }
+        out() << "-----------------------------------------\n";
+        HashTableStats s = stats();
+        out() << "Parcels: " << s.size << " | Slots: " << s.capacity 
+             << " | Tombstones: " << s.tombstones << " | Load: " << fixed << setprecision(2) << s.loadFactor 
+             << "\nProbe length (groups): avg " << s.avgProbeLength << ", max " << s.maxProbeLength << "\n";
+        out().unsetf(ios::fixed);
+        out() << setprecision(6);
+    }
+};
+
+class ParcelIndex 
+{
+public:
+    class Iterator 
+    {
+    private:
+        Parcel* current;
+        int kind;
+
+    public:
+        Iterator(Parcel* p, int k) : current(p), kind(k) {}
+        Parcel* operator*() const { return current; }
+        Iterator& operator++() 
+        {
+            current = current->links[kind].next;
+            return *this;
+        }
+        bool operator!=(const Iterator& other) const { return current != other.current; }
+    };
+
+    class Range 
+    {
+    private:
+        Parcel* first;
+        int kind;
+        int count;
+
+    public:
+        Range(Parcel* f, int k, int n) : first(f), kind(k), count(n) {}
+        Iterator begin() const { return Iterator(first, kind); }
+        Iterator end() const { return Iterator(nullptr, kind); }
+        int size() const { return count; }
+    };
+
+private:
+    Parcel** heads[INDEX_KIND_COUNT];
+    int* counts[INDEX_KIND_COUNT];
+    int keyCount[INDEX_KIND_COUNT];
+    int zoneCount;
+
+    int keyFor(const Parcel* p, int kind, int status, int rider) const 
+    {
+        switch (kind) 
+        {
+            case INDEX_STATUS: return status;
+            case INDEX_ZONE: return p->zoneId();
+            case INDEX_STATUS_ZONE: return status * zoneCount + p->zoneId();
+            case INDEX_DESTINATION: return p->destCity;
+            case INDEX_RIDER: return rider;
+        }
+        return -1;
+    }
+
+    void link(Parcel* p, int kind, int key) 
+    {
+        if (key < 0 || key >= keyCount[kind]) 
+            return;
+        ParcelLink& l = p->links[kind];
+        l.prev = nullptr;
+        l.next = heads[kind][key];
+        if (l.next) 
+            l.next->links[kind].prev = p;
+        heads[kind][key] = p;
+        counts[kind][key]++;
+    }
+
+    void unlink(Parcel* p, int kind, int key) 
+    {
+        if (key < 0 || key >= keyCount[kind]) 
+            return;
+        ParcelLink& l = p->links[kind];
+        if (l.prev) 
+            l.prev->links[kind].next = l.next;
+        else 
+            heads[kind][key] = l.next;
+        if (l.next) 
+            l.next->links[kind].prev = l.prev;
+        l.prev = l.next = nullptr;
+        counts[kind][key]--;
+    }
+
+    Range range(int kind, int key) const 
+    {
+        if (key < 0 || key >= keyCount[kind]) 
+            return Range(nullptr, kind, 0);
+        return Range(heads[kind][key], kind, counts[kind][key]);
+    }
+
+public:
+    ParcelIndex() : zoneCount(0) 
+    {
+        for (int k = 0; k < INDEX_KIND_COUNT; k++) 
+        {
+            heads[k] = nullptr;
+            counts[k] = nullptr;
+            keyCount[k] = 0;
+        }
+    }
+
+    ~ParcelIndex() 
+    {
+        for (int k = 0; k < INDEX_KIND_COUNT; k++) 
+        {
+            delete[] heads[k];
+            delete[] counts[k];
+        }
+    }
+
+    void init(int zones, int cities, int riders) 
+    {
+        zoneCount = zones;
+        keyCount[INDEX_STATUS] = STATUS_COUNT;
+        keyCount[INDEX_ZONE] = zones;
+        keyCount[INDEX_STATUS_ZONE] = STATUS_COUNT * zones;
+        keyCount[INDEX_DESTINATION] = cities;
+        keyCount[INDEX_RIDER] = riders;
+        for (int k = 0; k < INDEX_KIND_COUNT; k++) 
+        {
+            delete[] heads[k];
+            delete[] counts[k];
+            heads[k] = new Parcel*[keyCount[k]];
+            counts[k] = new int[keyCount[k]];
+            for (int i = 0; i < keyCount[k]; i++) 
+            {
+                heads[k][i] = nullptr;
+                counts[k][i] = 0;
+            }
+        }
+    }
+
+    void add(Parcel* p) 
+    {
+        if (p->indexed) 
+            return;
+        for (int k = 0; k < INDEX_KIND_COUNT; k++) 
+            link(p, k, keyFor(p, k, p->status(), p->riderId));
+        p->indexed = true;
+    }
+
+    void remove(Parcel* p) 
+    {
+        if (!p->indexed) 
+            return;
+        for (int k = 0; k < INDEX_KIND_COUNT; k++) 
+            unlink(p, k, keyFor(p, k, p->status(), p->riderId));
+        p->indexed = false;
+    }
+
+    void onStatusChanged(Parcel* p, int oldStatus) 
+    {
+        if (!p->indexed || oldStatus == p->status()) 
+            return;
+        unlink(p, INDEX_STATUS, keyFor(p, INDEX_STATUS, oldStatus, p->riderId));
+        unlink(p, INDEX_STATUS_ZONE, keyFor(p, INDEX_STATUS_ZONE, oldStatus, p->riderId));
+        link(p, INDEX_STATUS, keyFor(p, INDEX_STATUS, p->status(), p->riderId));
+        link(p, INDEX_STATUS_ZONE, keyFor(p, INDEX_STATUS_ZONE, p->status(), p->riderId));
+    }
+
+    void onRiderChanged(Parcel* p, int oldRider) 
+    {
+        if (!p->indexed || oldRider == p->riderId) 
+            return;
+        unlink(p, INDEX_RIDER, oldRider);
+        link(p, INDEX_RIDER, p->riderId);
+    }
+
+    Range byStatus(int status) const 
+    {
+        return range(INDEX_STATUS, status);
+    }
+
+    Range byZone(int zoneId) const 
+    {
+        return range(INDEX_ZONE, zoneId);
+    }
+
+    Range byStatusAndZone(int status, int zoneId) const 
+    {
+        if (zoneId < 0 || zoneId >= zoneCount) 
+            return Range(nullptr, INDEX_STATUS_ZONE, 0);
+        return range(INDEX_STATUS_ZONE, status * zoneCount + zoneId);
+    }
+
+    Range byDestination(int city) const 
+    {
+        return range(INDEX_DESTINATION, city);
+    }
+
+    Range byRider(int rider) const 
+    {
+        return range(INDEX_RIDER, rider);
+    }
+};
+
+struct UndoAction 
+{ 
+    string type; 
+    string parcelId; 
+};
+
+struct UndoNode 
+{ 
+    UndoAction data; 
+    UndoNode* next; 
+    UndoNode(UndoAction d) : data(d), next(nullptr) {} 
+};
+
+class ActionStack 
+{
+private:
+    UndoNode* topNode;
+    ObjectPool<UndoNode> nodes;
+    int depth;
+
+public:
+    ActionStack() : topNode(nullptr), depth(0) {}
+
+    ~ActionStack() 
+    {
+        UndoAction discard;
+        while (pop(discard)) 
+            ;
+    }
+    
+    void push(string type, string id) 
+    { 
+        UndoNode* n = nodes.create(UndoAction{type, id}); 
+        n->next = topNode; 
+        topNode = n; 
+        depth++;
+    }
+    
+    bool pop(UndoAction& dest) 
+    {
+        if(!topNode) 
+            return false;
+        
+        UndoNode* temp = topNode; 
+        dest = temp->data; 
+        topNode = topNode->next; 
+        nodes.destroy(temp); 
+        depth--;
+        
+        return true;
+    }
+
+    int size() const 
+    {
+        return depth;
+    }
+
+    // Calls fn(action) from the oldest action to the newest.
+    template <typename Fn> 
+    void forEachFromBottom(Fn fn) const 
+    {
+        UndoNode** order = new UndoNode*[depth > 0 ? depth : 1];
+        int i = depth;
+        for (UndoNode* n = topNode; n; n = n->next) 
+            order[--i] = n;
+        for (i = 0; i < depth; i++) 
+            fn(order[i]->data);
+        delete[] order;
+    }
+};
+
+class RiderManager {
+private:
+    Rider* riders;
+    int riderCount;
+    
+public:
+    RiderManager() : riderCount(4) {
         riders = new Rider[4] {
             Rider("Ali Khan", "Light", 50),
             Rider("Bilal Ahmed", "Heavy", 200),
@@ -1046,457 +4642,2529 @@ public:
         };
     }
     
-    ~RiderManager() {
-        delete[] riders;
+    ~RiderManager() {
+        delete[] riders;
+    }
+    
+    int count() const {
+        return riderCount;
+    }
+    
+    string riderLabel(int i) const {
+        return riders[i].name + " (" + riders[i].type + ")";
+    }
+
+    const Rider& rider(int i) const {
+        return riders[i];
+    }
+
+    void restore(int i, int load, int assigned, bool available) {
+        if (i < 0 || i >= riderCount) {
+            return;
+        }
+        riders[i].currentLoad = load;
+        riders[i].parcelsAssigned = assigned;
+        riders[i].available = available;
+    }
+    
+    int findRider(const string& name) const {
+        for(int i = 0; i < riderCount; i++) {
+            if (riders[i].name == name || riderLabel(i) == name) {
+                return i;
+            }
+        }
+        return -1;
+    }
+    
+    int assignRider(Parcel* parcel) {
+        int bestRider = -1;
+        int bestScore = -1;
+        
+        for(int i = 0; i < riderCount; i++) {
+            if(riders[i].available) {
+                int score = 0;
+                
+                if (parcel->priority == 3 && riders[i].type == "Priority") {
+                    score += 100;
+                }
+                
+                if (parcel->weightCategory == "Heavy" && riders[i].type == "Heavy") {
+                    score += 80;
+                } else if (parcel->weightCategory == "Light" && riders[i].type == "Light") {
+                    score += 80;
+                }
+                
+                int loadPercentage = (riders[i].currentLoad * 100) / riders[i].maxLoad;
+                score += (100 - loadPercentage);
+                
+                if (score > bestScore) {
+                    bestScore = score;
+                    bestRider = i;
+                }
+            }
+        }
+        
+        if (bestRider != -1) {
+            riders[bestRider].currentLoad += parcel->weight;
+            riders[bestRider].parcelsAssigned++;
+            if (riders[bestRider].currentLoad >= riders[bestRider].maxLoad * 0.9) {
+                riders[bestRider].available = false;
+            }
+        }
+        
+        return bestRider;
+    }
+    
+    void releaseRider(int i) {
+        if (i < 0 || i >= riderCount) {
+            return;
+        }
+        riders[i].currentLoad = max(0, riders[i].currentLoad - 10);
+        if (riders[i].currentLoad < riders[i].maxLoad * 0.7) {
+            riders[i].available = true;
+        }
+    }
+    
+    void showRiderStatus() {
+        clearScreen();
+        out() << "\n=== RIDER STATUS ===\n";
+        out() << left << setw(20) << "Name" << setw(10) << "Type" 
+             << setw(10) << "Load" << setw(10) << "Max" 
+             << setw(10) << "Parcels" << setw(0) << "Status\n";
+        for(int i = 0; i < riderCount; i++) {
+            out() << setw(20) << riders[i].name 
+                 << setw(10) << riders[i].type
+                 << setw(10) << riders[i].currentLoad 
+                 << setw(10) << riders[i].maxLoad
+                 << setw(10) << riders[i].parcelsAssigned
+                 << setw(10) << (riders[i].available ? "Available" : "Busy") << endl;
+        }
+    }
+};
+
+long long elapsedMicros(chrono::steady_clock::time_point since) 
+{
+    return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - since).count();
+}
+
+// Streaming reader for pickup manifests. Reads the file through a fixed
+// buffer and splits each line on ',' or '\t' (detected from the first
+// line). Double-quoted fields may contain the delimiter and "" escapes.
+class ManifestReader 
+{
+private:
+    static const int BUFFER_SIZE = 1 << 16;
+    static const int MAX_FIELDS = 8;
+
+    FILE* file;
+    char* buffer;
+    int length;
+    int pos;
+    char delimiter;
+    string fields[MAX_FIELDS];
+    int fieldCount;
+    int lineNumber;
+
+    bool refill() 
+    {
+        length = (int)fread(buffer, 1, BUFFER_SIZE, file);
+        pos = 0;
+        return length > 0;
+    }
+
+    int nextChar() 
+    {
+        if (pos == length && !refill()) 
+            return EOF;
+        return (unsigned char)buffer[pos++];
+    }
+
+    int peekChar() 
+    {
+        if (pos == length && !refill()) 
+            return EOF;
+        return (unsigned char)buffer[pos];
+    }
+
+public:
+    ManifestReader() : file(nullptr), length(0), pos(0), delimiter(0), fieldCount(0), lineNumber(0) 
+    {
+        buffer = new char[BUFFER_SIZE];
+    }
+
+    ~ManifestReader() 
+    {
+        close();
+        delete[] buffer;
+    }
+
+    bool open(const string& path) 
+    {
+        close();
+        file = fopen(path.c_str(), "rb");
+        length = pos = 0;
+        lineNumber = 0;
+        delimiter = 0;
+        return file != nullptr;
+    }
+
+    void close() 
+    {
+        if (file) 
+            fclose(file);
+        file = nullptr;
+    }
+
+    long fileSize() 
+    {
+        if (!file) 
+            return 0;
+        long here = ftell(file);
+        fseek(file, 0, SEEK_END);
+        long size = ftell(file);
+        fseek(file, here, SEEK_SET);
+        return size;
+    }
+
+    // Reads the next non-empty record; returns false at end of file.
+    bool nextRecord() 
+    {
+        while (true) 
+        {
+            int c = peekChar();
+            if (c == EOF) 
+                return false;
+
+            lineNumber++;
+            fieldCount = 0;
+            for (int i = 0; i < MAX_FIELDS; i++) 
+                fields[i].clear();
+
+            bool inQuotes = false;
+            bool any = false;
+            while ((c = nextChar()) != EOF) 
+            {
+                if (inQuotes) 
+                {
+                    if (c == '"') 
+                    {
+                        if (peekChar() == '"') 
+                            fields[fieldCount] += (char)nextChar();
+                        else 
+                            inQuotes = false;
+                    }
+                    else 
+                        fields[fieldCount] += (char)c;
+                    continue;
+                }
+                if (c == '\n') 
+                    break;
+                if (c == '\r') 
+                    continue;
+                if (delimiter == 0 && (c == ',' || c == '\t')) 
+                    delimiter = (char)c;
+                any = true;
+                if (c == '"') 
+                    inQuotes = true;
+                else if (c == delimiter) 
+                {
+                    if (fieldCount < MAX_FIELDS - 1) 
+                        fieldCount++;
+                }
+                else 
+                    fields[fieldCount] += (char)c;
+            }
+            if (any) 
+            {
+                fieldCount++;
+                return true;
+            }
+        }
+    }
+
+    int size() const 
+    {
+        return fieldCount;
+    }
+
+    string field(int i) const 
+    {
+        string s = (i < fieldCount) ? fields[i] : "";
+        size_t b = s.find_first_not_of(" \t");
+        size_t e = s.find_last_not_of(" \t");
+        return (b == string::npos) ? "" : s.substr(b, e - b + 1);
+    }
+
+    int line() const 
+    {
+        return lineNumber;
+    }
+};
+
+enum WalRecordType 
+{
+    WAL_PARCEL = 1,
+    WAL_EVENT,
+    WAL_REMOVE,
+    WAL_ROAD,
+    WAL_RIDER,
+    WAL_UNDO_PUSH,
+    WAL_UNDO_POP
+};
+
+// Little growable byte buffer used to encode log records and whole
+// snapshots; sizes are 64-bit because a snapshot can pass 2 GB.
+class ByteBuffer 
+{
+private:
+    char* data;
+    long long capacity;
+    long long count;
+
+    void reserve(long long extra) 
+    {
+        if (count + extra <= capacity) 
+            return;
+        while (capacity < count + extra) 
+            capacity *= 2;
+        char* grown = new char[capacity];
+        memcpy(grown, data, count);
+        delete[] data;
+        data = grown;
+    }
+
+public:
+    ByteBuffer() : capacity(256), count(0) 
+    {
+        data = new char[capacity];
+    }
+
+    ~ByteBuffer() 
+    {
+        delete[] data;
+    }
+
+    ByteBuffer(const ByteBuffer&) = delete;
+    ByteBuffer& operator=(const ByteBuffer&) = delete;
+
+    void put(const void* bytes, long long n) 
+    {
+        reserve(n);
+        memcpy(data + count, bytes, n);
+        count += n;
+    }
+
+    void putU8(int v) 
+    {
+        unsigned char b = (unsigned char)v;
+        put(&b, 1);
+    }
+
+    void putI32(int v) 
+    {
+        put(&v, 4);
+    }
+
+    void putI64(long long v) 
+    {
+        put(&v, 8);
+    }
+
+    void putDouble(double v) 
+    {
+        put(&v, 8);
+    }
+
+    void putString(const string& s) 
+    {
+        putI32((int)s.size());
+        put(s.data(), (int)s.size());
+    }
+
+    const char* bytes() const 
+    {
+        return data;
+    }
+
+    long long size() const 
+    {
+        return count;
+    }
+
+    void clear() 
+    {
+        count = 0;
+    }
+};
+
+// Bounds-checked decoder for one record payload; any overrun clears ok.
+class ByteReader 
+{
+private:
+    const char* data;
+    int count;
+    int pos;
+
+    bool take(void* out, int n) 
+    {
+        if (!ok || n < 0 || pos + n > count) 
+        {
+            ok = false;
+            return false;
+        }
+        memcpy(out, data + pos, n);
+        pos += n;
+        return true;
+    }
+
+public:
+    bool ok;
+
+    ByteReader(const char* d, int n) : data(d), count(n), pos(0), ok(true) {}
+
+    int u8() 
+    {
+        unsigned char b = 0;
+        take(&b, 1);
+        return b;
+    }
+
+    int i32() 
+    {
+        int v = 0;
+        take(&v, 4);
+        return v;
+    }
+
+    long long i64() 
+    {
+        long long v = 0;
+        take(&v, 8);
+        return v;
+    }
+
+    double f64() 
+    {
+        double v = 0;
+        take(&v, 8);
+        return v;
+    }
+
+    string str() 
+    {
+        int n = i32();
+        if (!ok || n < 0 || pos + n > count) 
+        {
+            ok = false;
+            return "";
+        }
+        string s(data + pos, n);
+        pos += n;
+        return s;
+    }
+};
+
+// Append-only record log. Each record is framed as
+//   [u32 payload length][u8 type][payload][u32 FNV-1a of type+payload]
+// so a torn write at the tail is detected and ignored on replay. append()
+// only buffers; commit() writes everything buffered since the last commit
+// and fsyncs once (group commit).
+class WriteAheadLog 
+{
+private:
+    FILE* file;
+    ByteBuffer pending;
+    long long written;
+    int records;
+
+    static unsigned int checksum(int type, const char* bytes, int n) 
+    {
+        unsigned int h = 2166136261u;
+        h ^= (unsigned char)type;
+        h *= 16777619u;
+        for (int i = 0; i < n; i++) 
+        {
+            h ^= (unsigned char)bytes[i];
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+    // 64-bit size of an open file; plain ftell() is 32-bit on Windows.
+    static long long fileSize(FILE* f) 
+    {
+#ifdef _WIN32
+        _fseeki64(f, 0, SEEK_END);
+        long long size = _ftelli64(f);
+        _fseeki64(f, 0, SEEK_SET);
+#else
+        fseeko(f, 0, SEEK_END);
+        long long size = (long long)ftello(f);
+        fseeko(f, 0, SEEK_SET);
+#endif
+        return size;
+    }
+
+    static bool syncFile(FILE* f) 
+    {
+        if (fflush(f) != 0) 
+            return false;
+#ifdef _WIN32
+        return _commit(_fileno(f)) == 0;
+#else
+        return fsync(fileno(f)) == 0;
+#endif
+    }
+
+public:
+    WriteAheadLog() : file(nullptr), written(0), records(0) {}
+
+    ~WriteAheadLog() 
+    {
+        close();
+    }
+
+    bool isOpen() const 
+    {
+        return file != nullptr;
+    }
+
+    // truncate starts a fresh log; otherwise records are appended.
+    bool open(const string& path, bool truncate) 
+    {
+        close();
+        file = fopen(path.c_str(), truncate ? "wb" : "ab");
+        written = 0;
+        records = 0;
+        return file != nullptr;
+    }
+
+    void close() 
+    {
+        if (file) 
+        {
+            commit();
+            fclose(file);
+            file = nullptr;
+        }
+    }
+
+    void append(int type, const ByteBuffer& payload) 
+    {
+        if (!file) 
+            return;
+        int n = (int)payload.size();
+        unsigned char t = (unsigned char)type;
+        unsigned int sum = checksum(type, payload.bytes(), n);
+        pending.put(&n, 4);
+        pending.put(&t, 1);
+        pending.put(payload.bytes(), n);
+        pending.put(&sum, 4);
+        records++;
+    }
+
+    // Returns false if the buffered records could not be written and
+    // synced. They are dropped either way, so after a failure the caller
+    // must stop treating the log as durable.
+    bool commit() 
+    {
+        if (!file || pending.size() == 0) 
+            return true;
+        bool ok = fwrite(pending.bytes(), 1, pending.size(), file) == (size_t)pending.size();
+        ok = syncFile(file) && ok;
+        if (ok) 
+            written += pending.size();
+        pending.clear();
+        return ok;
+    }
+
+    long long bytesWritten() const 
+    {
+        return written + pending.size();
+    }
+
+    int recordCount() const 
+    {
+        return records;
+    }
+
+    // Writes a finished record stream to path atomically (temp file, fsync,
+    // rename), for snapshots.
+    static bool writeFile(const string& path, const ByteBuffer& stream) 
+    {
+        string temp = path + ".tmp";
+        FILE* f = fopen(temp.c_str(), "wb");
+        if (!f) 
+            return false;
+        bool ok = fwrite(stream.bytes(), 1, stream.size(), f) == (size_t)stream.size();
+        ok = syncFile(f) && ok;
+        ok = fclose(f) == 0 && ok;
+        if (!ok) 
+            return false;
+#ifdef _WIN32
+        // rename() will not replace an existing file here.
+        remove(path.c_str());
+        return rename(temp.c_str(), path.c_str()) == 0;
+#else
+        // rename() replaces path atomically; syncing the directory makes
+        // the new entry itself durable.
+        if (rename(temp.c_str(), path.c_str()) != 0) 
+            return false;
+        size_t slash = path.find_last_of('/');
+        string dir = (slash == string::npos) ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+        int fd = ::open(dir.c_str(), O_RDONLY);
+        if (fd < 0) 
+            return false;
+        bool synced = fsync(fd) == 0;
+        ::close(fd);
+        return synced;
+#endif
+    }
+
+    // Frames payload into stream the same way append() does, so snapshots
+    // and the log share one format and one replay path.
+    static void frame(ByteBuffer& stream, int type, const ByteBuffer& payload) 
+    {
+        int n = (int)payload.size();
+        unsigned char t = (unsigned char)type;
+        unsigned int sum = checksum(type, payload.bytes(), n);
+        stream.put(&n, 4);
+        stream.put(&t, 1);
+        stream.put(payload.bytes(), n);
+        stream.put(&sum, 4);
+    }
+
+    // Calls apply(type, reader) for every intact record in path, stopping
+    // at the first torn or corrupt one. Returns the number applied, or -1
+    // if the file does not exist.
+    template <typename Fn> 
+    static int replay(const string& path, Fn apply) 
+    {
+        FILE* f = fopen(path.c_str(), "rb");
+        if (!f) 
+            return -1;
+        long long size = fileSize(f);
+        char* bytes = new char[size > 0 ? size : 1];
+        long long got = size > 0 ? (long long)fread(bytes, 1, (size_t)size, f) : 0;
+        fclose(f);
+
+        int applied = 0;
+        long long pos = 0;
+        while (pos + 9 <= got) 
+        {
+            int n;
+            memcpy(&n, bytes + pos, 4);
+            if (n < 0 || pos + 9 + n > got) 
+                break;
+            int type = (unsigned char)bytes[pos + 4];
+            const char* payload = bytes + pos + 5;
+            unsigned int sum;
+            memcpy(&sum, payload + n, 4);
+            if (sum != checksum(type, payload, n)) 
+                break;
+            ByteReader reader(payload, n);
+            apply(type, reader);
+            applied++;
+            pos += 9 + n;
+        }
+        delete[] bytes;
+        return applied;
+    }
+};
+
+class LogisticsEngine : public RoadEventListener, public ParcelObserver 
+{
+private:
+    // Hot parcel columns and shared routes; declared before the pool so
+    // every parcel's slot and route outlive the parcel.
+    ParcelStore parcelStore;
+    RouteTable routeTable;
+    // Owns every parcel; declared early so it outlives the structures
+    // that point into it.
+    ObjectPool<Parcel> parcels;
+    ParcelHashTable database;
+    ParcelHeap sortingQueue;
+    ParcelLinkedList shippingList;
+    RiderManager riderManager;
+    MapGraph map;
+    ActionStack undoStack;
+    ParcelIndex index;
+    TimerWheel timers;
+    IntArrayList expired;
+    LifecycleStepper stepper;
+    RouteOccupancy occupancy;
+    BatchRerouter rerouter;
+    IntArrayList pendingRoads;
+    ParcelArrayList rerouteBatch;
+    unsigned int rerouteStamp;
+    int hubCity;
+    RouteSelection routeSelection;
+    int fixedRoute;
+
+    // Durability: mutations go to <dataPath>.wal and are committed once per
+    // tick; <dataPath>.snapshot holds the last compacted image. The log is
+    // compacted once it outgrows both SNAPSHOT_WAL_BYTES and that image,
+    // so rewriting the snapshot stays proportional to the log written.
+    static const long long SNAPSHOT_WAL_BYTES = 4LL << 20;
+    WriteAheadLog wal;
+    long long lastSnapshotBytes;
+    string dataPath;
+    bool persistent;
+    bool recovering;
+    bool ridersDirty;
+    ParcelArrayList walDirty;
+    
+public:
+    LogisticsEngine() : rerouteStamp(0), routeSelection(ROUTE_PROMPT), fixedRoute(0), 
+                        lastSnapshotBytes(0), persistent(false), recovering(false), ridersDirty(false) 
+    {
+        srand(time(0));
+        simSeed = mix64(time(0));
+        stepper.setThreads(thread::hardware_concurrency());
+        setupMap();
+        map.setListener(this);
+        occupancy.init(map.edgeCount);
+        index.init(map.zoneCount(), map.cityCount, riderManager.count());
+        timers.start(nowMs());
+    }
+
+    // The pool frees its slabs without running destructors, so the engine
+    // destroys every parcel it still owns; that also hands back their
+    // strings, store slots and route references.
+    ~LogisticsEngine() 
+    {
+        database.forEach([this](Parcel* p) { parcels.destroy(p); });
+    }
+
+    void setRouteSelection(RouteSelection selection, int fixed = 0) 
+    {
+        routeSelection = selection;
+        fixedRoute = fixed;
+    }
+
+    // Reseeds both the global rand() used for dispatch decisions and the
+    // per-parcel lifecycle streams, making a run repeatable.
+    void setSeed(unsigned long long seed) 
+    {
+        srand((unsigned int)seed);
+        simSeed = mix64(seed);
+    }
+
+    void setThreads(int threads) 
+    {
+        stepper.setThreads(threads);
+    }
+
+    int queuedCount() 
+    {
+        return sortingQueue.size();
+    }
+
+    void onStatusChanged(Parcel* p, int oldStatus) 
+    {
+        index.onStatusChanged(p, oldStatus);
+        shippingList.track(p);
+        // Parcels back in the warehouse or in a final state give up their
+        // road load and their interned route.
+        if (p->status() < STATUS_LOADING || p->status() > STATUS_DELIVERY_ATTEMPT) 
+        {
+            occupancy.release(p, map);
+            if (p->hasRoute()) 
+                p->setRoute(Route(), 0);
+        }
+        scheduleLifecycle(p);
+        markDirty(p);
+    }
+
+    void onRiderChanged(Parcel* p, int oldRider) 
+    {
+        index.onRiderChanged(p, oldRider);
+        ridersDirty = true;
+        markDirty(p);
+    }
+
+    void scheduleLifecycle(Parcel* p) 
+    {
+        long long due = lifecycleDeadline(parcelStore, p->slot, nowMs());
+        if (due == LLONG_MAX) 
+            timers.cancel(p->slot);
+        else 
+            timers.schedule(p->slot, due);
+    }
+
+    void onRoadBlocked(int edge) 
+    {
+        if (recovering) 
+            return;
+        logRoad(edge, true);
+        out() << ">>> [ALERT] Road " << roadLabel(edge) << " is now BLOCKED!\n";
+        pendingRoads.add(map.roadOf(edge));
+    }
+
+    void onRoadUnblocked(int edge) 
+    {
+        if (recovering) 
+            return;
+        logRoad(edge, false);
+        out() << ">>> [INFO] Road " << roadLabel(edge) << " is open again.\n";
+    }
+
+    void onRoadOverloaded(int edge) 
+    {
+        if (recovering) 
+            return;
+        out() << ">>> [ALERT] Road " << roadLabel(edge) << " is OVERLOADED! Temporarily closed.\n";
+        pendingRoads.add(map.roadOf(edge));
+    }
+
+    void onRoadCleared(int edge) 
+    {
+        if (recovering) 
+            return;
+        out() << ">>> [INFO] Road " << roadLabel(edge) << " is back under capacity.\n";
+    }
+
+    string roadLabel(int edge) 
+    {
+        return map.cityName(map.edgeDest[map.edgeTwin[edge]]) + " <-> " + map.cityName(map.edgeDest[edge]);
+    }
+
+    void setupMap() 
+    {
+        int lhr = map.addCity("Lahore", "Zone A");
+        int isb = map.addCity("Islamabad", "Zone B");
+        int khi = map.addCity("Karachi", "Zone C");
+        int pew = map.addCity("Peshawar", "Zone B");
+        int mux = map.addCity("Multan", "Zone A");
+        int fsd = map.addCity("Faisalabad", "Zone A");
+        int qta = map.addCity("Quetta", "Zone D");
+        int rwp = map.addCity("Rawalpindi", "Zone B");
+        int suk = map.addCity("Sukkur", "Zone C");
+        int sgd = map.addCity("Sargodha", "Zone A");
+        int bwp = map.addCity("Bahawalpur", "Zone D");
+        int guj = map.addCity("Gujranwala", "Zone A");
+        int swl = map.addCity("Sahiwal", "Zone A");
+        int okk = map.addCity("Okara", "Zone B");
+        int mbd = map.addCity("Mandi Bahauddin", "Zone C");
+        int ryk = map.addCity("Rahim Yar Khan", "Zone D");
+        int hfd = map.addCity("Hafizabad", "Zone A");
+        int skt = map.addCity("Sialkot", "Zone A");
+        int ghr = map.addCity("Gujrat", "Zone A");
+        int veh = map.addCity("Vehari", "Zone D");
+        int goj = map.addCity("Gojra", "Zone A");
+        int mrd = map.addCity("Mardan", "Zone B");
+        int swb = map.addCity("Swabi", "Zone B");
+        int gwd = map.addCity("Gwadar", "Zone D");
+        int hyd = map.addCity("Hyderabad", "Zone C");
+        
+        map.addRoad(lhr, isb, 375, 20);
+        map.addRoad(lhr, fsd, 180, 18);
+        map.addRoad(lhr, mux, 345, 15);
+        map.addRoad(lhr, guj, 70, 15);
+        map.addRoad(lhr, swl, 175, 12);
+        map.addRoad(lhr, okk, 100, 10);        
+        map.addRoad(isb, pew, 155, 18);
+        map.addRoad(isb, rwp, 20, 25);       
+        map.addRoad(fsd, sgd, 85, 15);
+        map.addRoad(fsd, goj, 30, 10);
+        map.addRoad(fsd, mux, 240, 15);        
+        map.addRoad(mux, bwp, 90, 12);
+        map.addRoad(mux, veh, 70, 10);
+        map.addRoad(mux, suk, 490, 15);        
+        map.addRoad(suk, khi, 470, 18);
+        map.addRoad(suk, hyd, 320, 15);
+        map.addRoad(suk, qta, 390, 12);        
+        map.addRoad(khi, hyd, 165, 20);
+        map.addRoad(khi, gwd, 700, 10);        
+        map.addRoad(qta, gwd, 700, 10);        
+        map.addRoad(pew, mrd, 50, 15);
+        map.addRoad(pew, swb, 70, 12);        
+        map.addRoad(mrd, swb, 40, 12);        
+        map.addRoad(guj, skt, 50, 15);
+        map.addRoad(guj, ghr, 40, 15);
+        map.addRoad(guj, hfd, 50, 12);        
+        map.addRoad(skt, ghr, 60, 12);        
+        map.addRoad(sgd, mbd, 110, 12);        
+        map.addRoad(bwp, ryk, 80, 12);       
+        map.addRoad(swl, okk, 50, 12);
+        map.addRoad(swl, veh, 120, 10);      
+        map.addRoad(hfd, lhr, 105, 15);
+        map.addRoad(hfd, fsd, 90, 12);       
+        map.addRoad(veh, bwp, 140, 10);       
+        map.addRoad(hyd, gwd, 550, 10);
+        map.freeze();
+        hubCity = lhr;
+    }
+
+    void displayAllCities() {
+        map.displayAllCities();
+    }
+    
+    // Parses and checks the weight and priority of a new pickup; the menu,
+    // scripts and manifest import all go through here. Returns why the
+    // pickup is rejected, or an empty string.
+    static string parsePickup(const string& weightText, const string& priorityText, double& w, int& priority) 
+    {
+        char* end = nullptr;
+        w = strtod(weightText.c_str(), &end);
+        if (weightText.empty() || *end != '\0' || !isfinite(w) || w <= 0) 
+            return "invalid weight '" + weightText + "'";
+        if (w > MAX_WEIGHT_KG) 
+            return "weight " + weightText + " kg is over the " + to_string((int)MAX_WEIGHT_KG) + " kg limit";
+        long value = strtol(priorityText.c_str(), &end, 10);
+        if (priorityText.empty() || *end != '\0' || value < 1 || value > 3) 
+            return "priority must be 1, 2 or 3";
+        priority = (int)value;
+        return "";
+    }
+
+    void requestPickup(string id, string dest, const string& weightText, const string& priorityText) 
+    {
+        clearScreen();
+        int destCity = map.getCityIndex(dest);
+        if (destCity == -1) 
+        { 
+            out() << "Error: Destination not valid.\n"; 
+            pauseFunc(); 
+            return; 
+        }
+
+        double w;
+        int p;
+        string error = parsePickup(weightText, priorityText, w, p);
+        if (!error.empty()) 
+        {
+            out() << "Error: " << error << ".\n";
+            pauseFunc();
+            return;
+        }
+        
+        if (database.search(id)) 
+        {
+            out() << "Error: ID already exists.\n"; 
+            pauseFunc(); 
+            return; 
+        }
+        
+        Parcel* newP = parcels.create(parcelStore, routeTable, id, destCity, w, p, map.cities[destCity].zoneId);
+        database.insert(newP); 
+        newP->observer = this;
+        index.add(newP);
+        
+        newP->updateStatus(STATUS_WAREHOUSE, EV_ARRIVED_WAREHOUSE);
+        
+        sortingQueue.insert(newP); 
+        
+        pushUndo("ADD", id);
+        out() << ">> Pickup Request Logged.\n";
+        out() << "   Category: " << newP->weightCategory << " | Zone: " << map.zoneName(newP->zoneId()) << "\n";
+        out() << "   Status: Moved to Warehouse Queue.\n";
+        pauseFunc();
+    }
+
+    void importManifest(const string& path) 
+    {
+        clearScreen();
+        ManifestReader reader;
+        if (!reader.open(path)) 
+        {
+            out() << "Error: Cannot open manifest '" << path << "'.\n";
+            pauseFunc();
+            return;
+        }
+
+        chrono::steady_clock::time_point started = chrono::steady_clock::now();
+        database.reserve(database.size() + (int)(reader.fileSize() / 16) + 1);
+
+        ParcelArrayList batch;
+        int rows = 0, rejected = 0, reported = 0;
+        while (reader.nextRecord()) 
+        {
+            string id = reader.field(0);
+            if (rows == 0 && (id == "id" || id == "ID" || id == "Id")) 
+                continue;
+            rows++;
+
+            string error;
+            string dest = reader.field(1);
+            double w = 0;
+            int priority = 0;
+            int destCity = map.getCityIndex(dest);
+
+            if (reader.size() < 4 || id.empty()) 
+                error = "expected id, destination, weight, priority";
+            else if (destCity == -1) 
+                error = "unknown destination '" + dest + "'";
+            else 
+                error = parsePickup(reader.field(2), reader.field(3), w, priority);
+            if (error.empty() && database.search(id)) 
+                error = "duplicate id " + id;
+
+            if (!error.empty()) 
+            {
+                rejected++;
+                if (reported++ < 10) 
+                    out() << "   line " << reader.line() << ": " << error << "\n";
+                continue;
+            }
+
+            Parcel* newP = parcels.create(parcelStore, routeTable, id, destCity, w, priority, map.cities[destCity].zoneId);
+            database.insert(newP);
+            newP->observer = this;
+            index.add(newP);
+            newP->updateStatus(STATUS_WAREHOUSE, EV_ARRIVED_WAREHOUSE_BULK);
+            batch.add(newP);
+        }
+        if (reported > 10) 
+            out() << "   ... " << (reported - 10) << " more rejected row(s)\n";
+
+        sortingQueue.bulkInsert(batch);
+
+        long long micros = elapsedMicros(started);
+        double seconds = micros / 1000000.0;
+        out() << ">> Manifest Imported: " << batch.size() << " parcel(s) queued, " 
+             << rejected << " rejected, " << rows << " row(s) read.\n";
+        out() << "   Time: " << fixed << setprecision(3) << seconds << "s";
+        if (micros > 0) 
+            out() << " (" << (long long)(rows / seconds) << " rows/sec)";
+        out() << "\n";
+        out().unsetf(ios::fixed);
+        out() << setprecision(6);
+        pauseFunc();
+    }
+
+    void processNext() 
+    {
+        clearScreen();
+        if(sortingQueue.isEmpty()) 
+        { 
+            out() << ">> Warehouse Queue Empty.\n"; 
+            pauseFunc(); 
+            return; 
+        }
+
+        Parcel* p = sortingQueue.extractMax(); 
+        int rider = riderManager.assignRider(p);
+        
+        if (rider == -1) {
+            out() << ">> No Suitable Riders Available! Parcel returned to queue.\n";
+            sortingQueue.insert(p);
+            pauseFunc();
+            return;
+        }
+        
+        p->setRider(rider, riderManager.riderLabel(rider));
+        
+        int start = hubCity;
+        int end = p->destCity;
+
+        out() << ">> Calculating routes for " << p->id << " to " << map.cityName(end) << "...\n";
+        map.findAllPaths(start, end);
+
+        if (map.pathCount == 0) 
+        {
+            out() << ">> ALERT: No paths available. Returning to Sender.\n";
+            p->updateStatus(STATUS_RETURNED, EV_NO_ROUTE);
+            riderManager.releaseRider(rider);
+            p->setRider(-1, "");
+            pauseFunc();
+            return;
+        }
+
+        int minIdx = map.getMinRouteIndex();
+        out() << "------------------------------------------------\n";
+        for(int i=0; i<map.pathCount; i++) 
+        {
+            out() << "   [" << i << "] Distance: " << map.availablePathDistances[i] << " km ";
+            if(i == minIdx) out() << "(RECOMMENDED - SHORTEST)";
+            out() << "\n       Path: ";
+            const Route& path = map.availablePaths[i];
+            for(int j=0; j<path.size(); j++) 
+            {
+                out() << map.cities[path.get(j)].name << (j < path.size()-1 ? " -> " : "");
+            }
+            out() << "\n";
+        }
+        out() << "------------------------------------------------\n";
+        
+        int choice = minIdx;
+        if (routeSelection == ROUTE_PROMPT) 
+        {
+            out() << ">> Select Route ID to Dispatch: ";
+            if (!(cin >> choice)) 
+            {
+                cin.clear();
+                choice = -1;
+            }
+        }
+        else if (routeSelection == ROUTE_FIXED) 
+            choice = fixedRoute;
+        
+        if (choice < 0 || choice >= map.pathCount) 
+        {
+            out() << "Invalid selection. Using Recommended Route.\n";
+            choice = minIdx;
+        }
+
+        if (rand() % 10 < 3)
+        { 
+            if (rand() % 2 == 0) {
+                out() << "\n>>> [LIVE UPDATE] Road Blockage Detected on selected route!\n";
+                map.blockRandomRoad();
+            } else {
+                out() << "\n>>> [LIVE UPDATE] Road Overload Detected on selected route!\n";
+                if (map.checkOverloads() == 0) 
+                    out() << ">>> Congestion cleared before it closed any road.\n";
+            }
+            
+            out() << ">>> Re-calculating Best Route automatically...\n";
+            map.findAllPaths(start, end); 
+            
+            if (map.pathCount > 0) 
+            {
+                choice = map.getMinRouteIndex(); 
+                out() << ">>> Rerouted to new optimal path.\n";
+            } 
+            else 
+            {
+                 out() << ">>> Rerouting Failed. Returning to Sender.\n";
+                 p->updateStatus(STATUS_RETURNED, EV_ROUTE_ISSUE);
+                 riderManager.releaseRider(rider);
+                 p->setRider(-1, "");
+                 pauseFunc();
+                 return;
+            }
+        }
+
+        p->setRoute(map.availablePaths[choice], map.availablePathDistances[choice]);
+        occupancy.attach(p, map);
+
+        p->updateStatus(STATUS_LOADING, EV_LOADING);
+        long long travelSecs = 10 + (rand() % 21);
+        p->dispatchTime() = nowMs();
+        p->arrivalTime() = p->dispatchTime() + travelSecs * 1000 + LOADING_MS; 
+        p->lastKnownTime() = p->dispatchTime();
+        pushUndo("DISPATCH", p->id);
+        markDirty(p);
+        
+        out() << "\n>> PARCEL DISPATCHED SUCCESSFULLY.\n";
+        out() << "   Rider: " << p->assignedRider << "\n   ETA: " << travelSecs << "s (transit) + 5s (loading)\n";
+        out() << "   Route Distance: " << p->currentRouteDistance << " km\n";
+        
+        pauseFunc();
+    }
+
+    void showMap() 
+    { 
+        map.displayNetwork(); 
+        pauseFunc(); 
+    }
+    
+    void showRiderStatus() {
+        riderManager.showRiderStatus();
+        pauseFunc();
+    }
+
+    void undoLast() 
+    {
+        clearScreen();
+        UndoAction act;
+        if(popUndo(act)) 
+        {
+            Parcel* p = database.search(act.parcelId);
+            if(p) 
+            {
+                if(act.type == "ADD") 
+                {
+                    sortingQueue.remove(p);
+                    p->updateStatus(STATUS_CANCELLED, EV_UNDO_ADD);
+                    out() << ">> Undo Add: Parcel " << p->id << " marked as cancelled.\n";
+                } 
+                else if (act.type == "DISPATCH") 
+                {
+                    p->updateStatus(STATUS_WAREHOUSE, EV_UNDO_DISPATCH);
+                    p->arrivalTime() = 0; 
+                    
+                    if (p->riderId != -1) {
+                        riderManager.releaseRider(p->riderId);
+                        p->setRider(-1, "");
+                    }
+                    sortingQueue.insert(p); 
+                    out() << ">> Undo Dispatch: Parcel " << p->id << " returned to warehouse.\n";
+                }
+            }
+        } 
+        else 
+        { 
+            out() << ">> Nothing to undo.\n"; 
+        }
+        
+        pauseFunc();
+    }
+
+    // One tick, then one group commit of everything it and the command
+    // before it changed.
+    void updateRealTime() 
+    {
+        tick();
+        commitLog();
+    }
+
+    void tick() 
+    {
+        long long now = nowMs();
+        
+        rerouteAffected();
+        
+        // Only parcels whose deadline has passed are touched.
+        expired.clear();
+        timers.expire(now, expired);
+        stepper.step(parcelStore, expired, now, map);
+        for (int i = 0; i < expired.size(); i++) 
+        {
+            Parcel* p = parcelStore.owner[expired.get(i)];
+            occupancy.advance(p, map);
+            scheduleLifecycle(p);
+            markDirty(p);
+        }
+    }
+    
+    // Runs the lifecycle on the virtual clock, jumping straight from one
+    // scheduled change to the next instead of waiting in real time.
+    void fastForward(long long durationMs) 
+    {
+        bool wasVirtual = simClock.isVirtual();
+        simClock.useVirtual();
+        long long start = nowMs();
+        long long end = start + durationMs;
+        int steps = 0;
+        auto t0 = chrono::steady_clock::now();
+        
+        while (true) 
+        {
+            long long next = timers.nextDue();
+            if (next > end) 
+                break;
+            simClock.advanceTo(next);
+            tick();
+            steps++;
+        }
+        simClock.advanceTo(end);
+        updateRealTime();
+        
+        long long us = elapsedMicros(t0);
+        out() << "\n>>> Fast-forwarded " << fixed << setprecision(1) << durationMs / 1000.0 
+              << "s of simulated time in " << steps << " steps (" << us / 1000.0 << " ms real).\n";
+        out().unsetf(ios::fixed);
+        if (!wasVirtual) 
+            simClock.useReal();
+    }
+    
+    // Reroutes only the parcels whose remaining route crosses a road that
+    // was blocked or overloaded since the last tick. Roads that trip while
+    // rerouting are handled on the next tick.
+    void rerouteAffected() 
+    {
+        if (pendingRoads.isEmpty()) 
+            return;
+        rerouteStamp++;
+        rerouteBatch.clear();
+        for (int i = 0; i < pendingRoads.size(); i++) 
+        {
+            // A blocked road sheds every parcel; an overloaded one only the
+            // parcels above its capacity, so the ones that filled it stay.
+            int road = pendingRoads.get(i);
+            int limit = occupancy.parcelsOn(road);
+            if (!map.edgeState[road].blocked) 
+                limit -= map.edgeMaxLoad[road];
+            occupancy.collect(road, limit, rerouteStamp, rerouteBatch);
+        }
+        pendingRoads.clear();
+        if (rerouter.reroute(rerouteBatch, map, stepper.workers(), occupancy) > 0) 
+            for (int i = 0; i < rerouteBatch.size(); i++) 
+                markDirty(rerouteBatch.get(i));
+    }
+    
+    void liveMonitor() 
+    {
+        char cmd = 'r';
+        while (cmd == 'r' || cmd == 'R') 
+        {
+            clearScreen();
+            long long now = nowMs();
+            updateRealTime();
+            shippingList.showTransitStatus(now, map);
+            out() << "\n[r] Refresh View   [x] Exit to Menu\nSelect: ";
+            cin >> cmd;
+        }
+    }
+
+    void viewParcel(string id) 
+    {
+        clearScreen();
+        Parcel* p = database.search(id);
+        if(p) 
+        {
+            out() << "\n==============================\n    PARCEL TRACKING DETAILS   \n==============================\n";
+            printParcelRow(out(), *p, map);
+            out() << endl;
+            out() << "Assigned Rider: " << (p->assignedRider.empty() ? "Not Assigned" : p->assignedRider) << endl;
+            if (p->hasRoute()) {
+                out() << "Route Distance: " << p->currentRouteDistance << " km\n";
+                out() << "Current Position: " << p->currentPosition() << "/" << p->route().size() << endl;     
+            }
+            p->history.printTimeline();
+            
+            if (p->status() == STATUS_IN_TRANSIT || p->status() == STATUS_LOADING) 
+            {
+                long long rem = (p->arrivalTime() - nowMs() + 999) / 1000;
+                if(rem > 0) out() << "\n>>> EST. DELIVERY IN: " << rem << " seconds\n";
+            }
+        } 
+        else 
+        { 
+            out() << "Parcel Not Found.\n"; 
+        }
+        
+        pauseFunc();
+    }
+
+    void printQueryResult(const ParcelIndex::Range& result) 
+    {
+        out() << "ID     DEST         CAT     ZONE     STATUS\n";
+        for (Parcel* p : result) 
+        {
+            printParcelRow(out(), *p, map);
+            if (p->riderId != -1) 
+                out() << "  " << p->assignedRider;
+            out() << endl;
+        }
+        out() << "-----------------------------------------\n";
+        out() << result.size() << " parcel(s) found.\n";
+    }
+
+    void showStatusSummary() 
+    {
+        clearScreen();
+        out() << "\n=== DASHBOARD: PARCELS PER STATUS ===\n";
+
+        // Straight column scans over every slot, independent of the indexes.
+        chrono::steady_clock::time_point started = chrono::steady_clock::now();
+        int n = parcelStore.slotCount();
+        int zones = map.zoneCount();
+        int* counts = new int[STATUS_COUNT * zones];
+        countByStatusZone(parcelStore.status, parcelStore.zone, n, zones, counts);
+
+        long long now = nowMs();
+        int* selected = new int[n > 0 ? n : 1];
+        int departures = selectDue(parcelStore.status, parcelStore.lastUpdateTime, n, STATUS_LOADING, now - LOADING_MS, selected);
+        int arrivals = selectDue(parcelStore.status, parcelStore.arrivalTime, n, STATUS_IN_TRANSIT, now, selected);
+        int silent = selectDue(parcelStore.status, parcelStore.lastKnownTime, n, STATUS_IN_TRANSIT, now - SIGNAL_TIMEOUT_MS - 1, selected);
+        long long micros = elapsedMicros(started);
+
+        out() << "     " << left << setw(22) << "Status" << setw(8) << "Total";
+        for (int z = 0; z < zones; z++) 
+            out() << setw(8) << map.zoneName(z);
+        out() << endl;
+        for (int s = 0; s < STATUS_COUNT; s++) 
+        {
+            int total = 0;
+            for (int z = 0; z < zones; z++) 
+                total += counts[s * zones + z];
+            out() << " [" << s << "] " << setw(22) << Parcel::statusName(s) << setw(8) << total;
+            for (int z = 0; z < zones; z++) 
+                out() << setw(8) << counts[s * zones + z];
+            out() << endl;
+        }
+        out() << "\nDue on the next tick: " << departures << " departure(s), " << arrivals 
+              << " arrival(s), " << silent << " signal timeout(s)\n";
+        out() << "Routes: " << routeTable.distinct() << " distinct, shared by " 
+              << routeTable.holders() << " parcel(s)\n";
+        out() << "Scanned " << n << " slot(s) in " << micros << " us\n";
+        delete[] counts;
+        delete[] selected;
+    }
+
+    void queryByStatus(int status, const string& zone) 
+    {
+        clearScreen();
+        if (zone.empty()) 
+            printQueryResult(index.byStatus(status));
+        else 
+        {
+            int zoneId = map.zoneIdOf(zone);
+            if (zoneId == -1) 
+                out() << "Unknown zone.\n";
+            else 
+                printQueryResult(index.byStatusAndZone(status, zoneId));
+        }
+        pauseFunc();
+    }
+
+    void queryByZone(const string& zone) 
+    {
+        clearScreen();
+        int zoneId = map.zoneIdOf(zone);
+        if (zoneId == -1) 
+            out() << "Unknown zone.\n";
+        else 
+            printQueryResult(index.byZone(zoneId));
+        pauseFunc();
+    }
+
+    void queryByDestination(const string& city) 
+    {
+        clearScreen();
+        int dest = map.getCityIndex(city);
+        if (dest == -1) 
+            out() << "Unknown city.\n";
+        else 
+            printQueryResult(index.byDestination(dest));
+        pauseFunc();
+    }
+
+    void queryByRider(const string& name) 
+    {
+        clearScreen();
+        int rider = riderManager.findRider(name);
+        if (rider == -1) 
+            out() << "Unknown rider.\n";
+        else 
+            printQueryResult(index.byRider(rider));
+        pauseFunc();
+    }
+
+    void listAll() 
+    { 
+        database.printAll(map); 
+        pauseFunc(); 
+    }
+    
+    void purgeFinished() 
+    {
+        clearScreen();
+        const int finished[] = {STATUS_DELIVERED, STATUS_RETURNED, STATUS_CANCELLED};
+        int removed = 0;
+        flushDirty();
+        for (int s = 0; s < 3; s++) 
+        {
+            while (index.byStatus(finished[s]).size() > 0) 
+            {
+                Parcel* p = *index.byStatus(finished[s]).begin();
+                index.remove(p);
+                database.remove(p->id);
+                timers.cancel(p->slot);
+                occupancy.release(p, map);
+                logRemove(p);
+                parcels.destroy(p);
+                removed++;
+            }
+        }
+        out() << ">> Purged " << removed << " finished parcel(s) from the database.\n";
+        out() << "   Remaining records: " << database.size() << "\n";
+        out() << "   Live parcels: " << parcels.size() << " | History chunks: " << trackingChunks.size() 
+              << " | Pool memory: " << (parcels.reservedBytes() + trackingChunks.reservedBytes()) / 1024 << " KB\n";
+        pauseFunc();
+    }
+    
+    void changePriority(string id, int newPriority) 
+    {
+        clearScreen();
+        Parcel* p = database.search(id);
+        if (newPriority < 1 || newPriority > 3) 
+        {
+            out() << ">> Error: Priority must be 1, 2 or 3.\n";
+        }
+        else if (!p || !sortingQueue.contains(p)) 
+        {
+            out() << ">> Error: Parcel is not waiting in the warehouse queue.\n";
+        }
+        else 
+        {
+            p->priority = newPriority;
+            sortingQueue.changePriority(p, Parcel::scoreFor(newPriority, p->weight));
+            markDirty(p);
+            out() << ">> Parcel " << id << " re-queued with priority " << newPriority << ".\n";
+        }
+        pauseFunc();
+    }
+    
+    void cancelParcel(string id) 
+    {
+        clearScreen();
+        Parcel* p = database.search(id);
+        if(p && p->status() <= STATUS_WAREHOUSE) 
+        {
+            sortingQueue.remove(p);
+            p->updateStatus(STATUS_CANCELLED, EV_CANCELLED);
+            out() << ">> Parcel " << id << " cancelled.\n";
+        } 
+        else if (p && p->status() == STATUS_IN_TRANSIT) {
+            out() << ">> Parcel is in transit. Attempting to reroute back...\n";
+            p->updateStatus(STATUS_RETURNED, EV_CANCELLED_IN_TRANSIT);
+        }
+        else 
+            out() << ">> Error: Cannot cancel (Already Delivered or Missing).\n";
+        
+        pauseFunc();
+    }
+    
+    void forceRouteRecalculation() {
+        clearScreen();
+        out() << ">>> Forcing route recalculation for all parcels in transit...\n";
+        rerouteBatch.clear();
+        for (int s = STATUS_LOADING; s <= STATUS_IN_TRANSIT; s++) 
+            for (Parcel* p = shippingList.first(s); p; p = ParcelLinkedList::next(p)) 
+                rerouteBatch.add(p);
+        int changed = rerouter.reroute(rerouteBatch, map, stepper.workers(), occupancy);
+        if (changed > 0) 
+            for (int i = 0; i < rerouteBatch.size(); i++) 
+                markDirty(rerouteBatch.get(i));
+        out() << ">>> " << changed << " of " << rerouteBatch.size() << " active parcel(s) moved to a better route.\n";
+        out() << ">>> Route recalculation complete.\n";
+        pauseFunc();
     }
-    
-    string assignRider(Parcel* parcel) {
-        int bestRider = -1;
-        int bestScore = -1;
-        
-        for(int i = 0; i < riderCount; i++) {
-            if(riders[i].available) {
-                int score = 0;
-                
-                if (parcel->priority == 3 && riders[i].type == "Priority") {
-                    score += 100;
-                }
-                
-                if (parcel->weightCategory == "Heavy" && riders[i].type == "Heavy") {
-                    score += 80;
-                } else if (parcel->weightCategory == "Light" && riders[i].type == "Light") {
-                    score += 80;
-                }
-                
-                int loadPercentage = (riders[i].currentLoad * 100) / riders[i].maxLoad;
-                score += (100 - loadPercentage);
-                
-                if (score > bestScore) {
-                    bestScore = score;
-                    bestRider = i;
-                }
+
+    void markDirty(Parcel* p) 
+    {
+        if (!persistent || p->walDirty) 
+            return;
+        p->walDirty = true;
+        walDirty.add(p);
+    }
+
+    void pushUndo(const string& type, const string& id) 
+    {
+        if (persistent) 
+        {
+            ByteBuffer b;
+            b.putI32(undoStack.size());
+            b.putString(type);
+            b.putString(id);
+            wal.append(WAL_UNDO_PUSH, b);
+        }
+        undoStack.push(type, id);
+    }
+
+    bool popUndo(UndoAction& act) 
+    {
+        if (persistent && undoStack.size() > 0) 
+        {
+            ByteBuffer b;
+            b.putI32(undoStack.size());
+            wal.append(WAL_UNDO_POP, b);
+        }
+        return undoStack.pop(act);
+    }
+
+    void logRoad(int road, bool blocked) 
+    {
+        if (!persistent) 
+            return;
+        ByteBuffer b;
+        b.putI32(road);
+        b.putU8(blocked ? 1 : 0);
+        wal.append(WAL_ROAD, b);
+    }
+
+    void logRemove(Parcel* p) 
+    {
+        if (!persistent) 
+            return;
+        ByteBuffer b;
+        b.putString(p->id);
+        wal.append(WAL_REMOVE, b);
+    }
+
+    static void encodeParcel(ByteBuffer& b, const Parcel* p) 
+    {
+        b.putString(p->id);
+        b.putI32(p->destCity);
+        b.putDouble(p->weight);
+        b.putI32(p->priority);
+        b.putI32(p->priorityScore);
+        b.putI32(p->status());
+        b.putI32(p->riderId);
+        b.putString(p->assignedRider);
+        b.putString(p->weightCategory);
+        b.putI32(p->zoneId());
+        b.putI32(p->deliveryAttempts());
+        b.putI64(p->dispatchTime());
+        b.putI64(p->lastUpdateTime());
+        b.putI64(p->arrivalTime());
+        b.putI64(p->lastKnownTime());
+        b.putI64(p->nextHopTime());
+        b.putI64((long long)p->rngKey());
+        b.putI32((int)p->rngDraws());
+        b.putI32(p->currentRouteDistance);
+        b.putI32(p->currentPosition());
+        const Route& route = p->route();
+        b.putI32(route.size());
+        for (int i = 0; i < route.size(); i++) 
+            b.putI32(route.get(i));
+    }
+
+    // Records go into snapshot when one is being built, else into the log.
+    void emit(ByteBuffer* snapshot, int type, const ByteBuffer& b) 
+    {
+        if (snapshot) 
+            WriteAheadLog::frame(*snapshot, type, b);
+        else 
+            wal.append(type, b);
+    }
+
+    // p's current image plus the history events not yet logged.
+    void writeParcel(Parcel* p, ByteBuffer* snapshot) 
+    {
+        ByteBuffer b;
+        encodeParcel(b, p);
+        emit(snapshot, WAL_PARCEL, b);
+
+        int from = snapshot ? 0 : p->walEvents;
+        p->history.forEach([&](int i, const TrackingRecord& r) {
+            if (i < from) 
+                return;
+            b.clear();
+            b.putString(p->id);
+            b.putI32(i);
+            b.putI32(r.event);
+            b.putString(locations.nameOf(r.location));
+            b.putI64(r.timeMs);
+            emit(snapshot, WAL_EVENT, b);
+        });
+        p->walEvents = p->history.size();
+    }
+
+    void writeRiders(ByteBuffer* snapshot) 
+    {
+        ByteBuffer b;
+        for (int i = 0; i < riderManager.count(); i++) 
+        {
+            const Rider& r = riderManager.rider(i);
+            b.clear();
+            b.putI32(i);
+            b.putI32(r.currentLoad);
+            b.putI32(r.parcelsAssigned);
+            b.putU8(r.available ? 1 : 0);
+            emit(snapshot, WAL_RIDER, b);
+        }
+        ridersDirty = false;
+    }
+
+    // Moves every queued parcel image into the log buffer without syncing.
+    void flushDirty() 
+    {
+        if (!persistent) 
+            return;
+        for (int i = 0; i < walDirty.size(); i++) 
+        {
+            Parcel* p = walDirty.get(i);
+            p->walDirty = false;
+            writeParcel(p, nullptr);
+        }
+        walDirty.clear();
+        if (ridersDirty) 
+            writeRiders(nullptr);
+    }
+
+    // Commits what the log has buffered. A failed write or fsync turns
+    // persistence off rather than acknowledging changes that are not on disk.
+    bool syncLog() 
+    {
+        if (wal.commit()) 
+            return true;
+        out() << ">> Error: Cannot write log '" << dataPath << ".wal'; persistence disabled.\n";
+        persistent = false;
+        wal.close();
+        return false;
+    }
+
+    // Group commit: one write and one fsync for everything changed since
+    // the last call. Compacts into a snapshot once the log grows too long.
+    void commitLog() 
+    {
+        if (!persistent) 
+            return;
+        flushDirty();
+        if (!syncLog()) 
+            return;
+        long long limit = (lastSnapshotBytes > SNAPSHOT_WAL_BYTES) ? lastSnapshotBytes : SNAPSHOT_WAL_BYTES;
+        if (wal.bytesWritten() > limit) 
+            writeSnapshot();
+    }
+
+    // Writes the full state as one record stream and starts an empty log.
+    // The snapshot is renamed into place before the log is truncated; if we
+    // stop in between, replaying the old log over the new snapshot still
+    // ends in the same state because every record is a full image or is
+    // applied only at its recorded position.
+    bool writeSnapshot() 
+    {
+        if (!persistent) 
+            return false;
+        flushDirty();
+        if (!syncLog()) 
+            return false;
+
+        ByteBuffer stream;
+        ByteBuffer b;
+        writeRiders(&stream);
+        for (int e = 0; e < map.edgeCount; e++) 
+        {
+            if (map.roadOf(e) != e || !map.edgeState[e].blocked) 
+                continue;
+            b.clear();
+            b.putI32(e);
+            b.putU8(1);
+            emit(&stream, WAL_ROAD, b);
+        }
+        database.forEach([&](Parcel* p) { writeParcel(p, &stream); });
+        int depth = 0;
+        undoStack.forEachFromBottom([&](const UndoAction& act) {
+            b.clear();
+            b.putI32(depth++);
+            b.putString(act.type);
+            b.putString(act.parcelId);
+            emit(&stream, WAL_UNDO_PUSH, b);
+        });
+
+        if (!WriteAheadLog::writeFile(dataPath + ".snapshot", stream)) 
+        {
+            out() << ">> Error: Cannot write snapshot '" << dataPath << ".snapshot'.\n";
+            return false;
+        }
+        lastSnapshotBytes = stream.size();
+        if (!wal.open(dataPath + ".wal", true)) 
+        {
+            out() << ">> Error: Cannot open log '" << dataPath << ".wal'; persistence disabled.\n";
+            persistent = false;
+            return false;
+        }
+        return true;
+    }
+
+    void applyRecord(int type, ByteReader& r) 
+    {
+        if (type == WAL_PARCEL) 
+        {
+            string id = r.str();
+            if (!r.ok) 
+                return;
+            Parcel* p = database.search(id);
+            if (!p) 
+            {
+                p = parcels.create(parcelStore, routeTable);
+                p->id = id;
+                database.insert(p);
+            }
+            p->destCity = r.i32();
+            p->weight = r.f64();
+            p->priority = r.i32();
+            p->priorityScore = r.i32();
+            p->setStatus(r.i32());
+            p->riderId = r.i32();
+            p->assignedRider = r.str();
+            p->weightCategory = r.str();
+            p->setZone(r.i32());
+            p->deliveryAttempts() = r.i32();
+            p->dispatchTime() = r.i64();
+            p->lastUpdateTime() = r.i64();
+            p->arrivalTime() = r.i64();
+            p->lastKnownTime() = r.i64();
+            p->nextHopTime() = r.i64();
+            p->rngKey() = (unsigned long long)r.i64();
+            p->rngDraws() = (unsigned int)r.i32();
+            int distance = r.i32();
+            int position = r.i32();
+            int hops = r.i32();
+            Route route;
+            for (int i = 0; i < hops && r.ok; i++) 
+                route.add(r.i32());
+            // Older logs may still carry routes for settled parcels.
+            if (p->status() < STATUS_LOADING || p->status() > STATUS_DELIVERY_ATTEMPT) 
+            {
+                p->setRoute(Route(), 0);
+            }
+            else 
+            {
+                p->setRoute(route, distance);
+                p->currentPosition() = position;
             }
         }
-        
-        if (bestRider != -1) {
-            riders[bestRider].currentLoad += parcel->weight;
-            riders[bestRider].parcelsAssigned++;
-            if (riders[bestRider].currentLoad >= riders[bestRider].maxLoad * 0.9) {
-                riders[bestRider].available = false;
+        else if (type == WAL_EVENT) 
+        {
+            string id = r.str();
+            int i = r.i32();
+            int event = r.i32();
+            string location = r.str();
+            long long timeMs = r.i64();
+            Parcel* p = r.ok ? database.search(id) : nullptr;
+            if (p && i == p->history.size() && event >= 0 && event < EV_COUNT) 
+                p->history.addEvent(event, locations.intern(location), timeMs);
+        }
+        else if (type == WAL_REMOVE) 
+        {
+            string id = r.str();
+            Parcel* p = r.ok ? database.search(id) : nullptr;
+            if (p) 
+            {
+                database.remove(id);
+                parcels.destroy(p);
             }
-            return riders[bestRider].name + " (" + riders[bestRider].type + ")";
         }
-        
-        return "";
-    }
-    
-    void releaseRider(string riderName) {
-        for(int i = 0; i < riderCount; i++) {
-            if (riders[i].name == riderName.substr(0, riderName.find(" ("))) {
-                riders[i].currentLoad = max(0, riders[i].currentLoad - 10);
-                if (riders[i].currentLoad < riders[i].maxLoad * 0.7) {
-                    riders[i].available = true;
-                }
-                break;
+        else if (type == WAL_ROAD) 
+        {
+            int e = r.i32();
+            bool blocked = r.u8() != 0;
+            if (r.ok && e >= 0 && e < map.edgeCount) 
+            {
+                if (blocked) 
+                    map.blockRoad(e);
+                else 
+                    map.unblockRoad(e);
             }
         }
+        else if (type == WAL_RIDER) 
+        {
+            int i = r.i32();
+            int load = r.i32();
+            int assigned = r.i32();
+            bool available = r.u8() != 0;
+            if (r.ok) 
+                riderManager.restore(i, load, assigned, available);
+        }
+        else if (type == WAL_UNDO_PUSH) 
+        {
+            int depth = r.i32();
+            string action = r.str();
+            string id = r.str();
+            UndoAction discard;
+            while (r.ok && undoStack.size() > depth) 
+                undoStack.pop(discard);
+            if (r.ok && undoStack.size() == depth) 
+                undoStack.push(action, id);
+        }
+        else if (type == WAL_UNDO_POP) 
+        {
+            int depth = r.i32();
+            UndoAction discard;
+            if (r.ok && undoStack.size() == depth) 
+                undoStack.pop(discard);
+        }
     }
-    
-    void showRiderStatus() {
-        clearScreen();
-        cout << "\n=== RIDER STATUS ===\n";
-        cout << left << setw(20) << "Name" << setw(10) << "Type" 
-             << setw(10) << "Load" << setw(10) << "Max" 
-             << setw(10) << "Parcels" << setw(0) << "Status\n";
-        for(int i = 0; i < riderCount; i++) {
-            cout << setw(20) << riders[i].name 
-                 << setw(10) << riders[i].type
-                 << setw(10) << riders[i].currentLoad 
-                 << setw(10) << riders[i].maxLoad
-                 << setw(10) << riders[i].parcelsAssigned
-                 << setw(10) << (riders[i].available ? "Available" : "Busy") << endl;
+
+    // Recovers from <prefix>.snapshot plus the tail in <prefix>.wal, then
+    // logs every later change there. Must run before any parcel exists.
+    bool enablePersistence(const string& prefix) 
+    {
+        if (persistent || database.size() > 0) 
+        {
+            out() << ">> Error: Persistence must be enabled once, before any parcel is created.\n";
+            return false;
+        }
+        chrono::steady_clock::time_point started = chrono::steady_clock::now();
+        dataPath = prefix;
+        recovering = true;
+        int fromSnapshot = WriteAheadLog::replay(prefix + ".snapshot",
+            [this](int type, ByteReader& r) { applyRecord(type, r); });
+        int fromLog = WriteAheadLog::replay(prefix + ".wal",
+            [this](int type, ByteReader& r) { applyRecord(type, r); });
+
+        // Replay only restores the durable fields; rebuild everything
+        // derived from them. Road loads come back through attach().
+        database.forEach([this](Parcel* p) {
+            p->observer = this;
+            p->walEvents = p->history.size();
+            index.add(p);
+            shippingList.track(p);
+            if (p->status() == STATUS_WAREHOUSE) 
+                sortingQueue.insert(p);
+            else if (p->status() >= STATUS_LOADING && p->status() <= STATUS_DELIVERY_ATTEMPT) 
+                occupancy.attach(p, map);
+            scheduleLifecycle(p);
+        });
+        recovering = false;
+        pendingRoads.clear();
+
+        if (!wal.open(prefix + ".wal", false)) 
+        {
+            out() << ">> Error: Cannot open log '" << prefix << ".wal'.\n";
+            return false;
         }
+        persistent = true;
+        writeSnapshot();
+
+        out() << ">> Persistence enabled at " << prefix << ".{snapshot,wal}\n";
+        out() << "   Recovered " << database.size() << " parcel(s) from "
+              << (fromSnapshot < 0 ? 0 : fromSnapshot) << " snapshot and "
+              << (fromLog < 0 ? 0 : fromLog) << " log record(s) in "
+              << elapsedMicros(started) / 1000 << " ms.\n";
+        return true;
+    }
+
+    void snapshot() 
+    {
+        if (!persistent) 
+            out() << ">> Error: Persistence is not enabled.\n";
+        else if (writeSnapshot()) 
+            out() << ">> Snapshot written to " << dataPath << ".snapshot\n";
     }
 };
 
-class LogisticsEngine 
+// Drives a LogisticsEngine from a command file, one command per line:
+//   pickup <id> <destination> <weight> <priority>   import <file>
+//   dispatch [count|all]      route <recommended|prompt|index>
+//   cancel <id>               priority <id> <1-3>
+//   undo   view <id>   list   map   riders   purge   reroute   tick   summary
+//   query status <n> [zone] | zone <zone> | dest <city> | rider <name>
+//   persist <path prefix>   snapshot
+//   echo <text>   quiet   verbose
+// Blank lines and lines starting with '#' are ignored.
+class ScriptRunner 
 {
 private:
-    ParcelHashTable database;
-    ParcelHeap sortingQueue;
-    ParcelLinkedList shippingList;
-    RiderManager riderManager;
-    MapGraph map;
-    ActionStack undoStack;
-    
+    static const int MAX_TOKENS = 16;
+
+    LogisticsEngine& engine;
+    int commands;
+    int errors;
+
+    static int split(const string& line, string tokens[]) 
+    {
+        stringstream ss(line);
+        int n = 0;
+        while (n < MAX_TOKENS && ss >> tokens[n]) 
+            n++;
+        return n;
+    }
+
+    static string join(const string tokens[], int from, int to) 
+    {
+        string s;
+        for (int i = from; i < to; i++) 
+        {
+            if (i > from) 
+                s += " ";
+            s += tokens[i];
+        }
+        return s;
+    }
+
+    void fail(int lineNo, const string& message) 
+    {
+        errors++;
+        cerr << "script line " << lineNo << ": " << message << "\n";
+    }
+
 public:
-    LogisticsEngine() 
+    ScriptRunner(LogisticsEngine& e) : engine(e), commands(0), errors(0) {}
+
+    int commandCount() const 
     {
-        srand(time(0));
-        setupMap();
+        return commands;
     }
 
-    void setupMap() 
+    int errorCount() const 
     {
-        int lhr = map.addCity("Lahore", "Zone A");
-        int isb = map.addCity("Islamabad", "Zone B");
-        int khi = map.addCity("Karachi", "Zone C");
-        int pew = map.addCity("Peshawar", "Zone B");
-        int mux = map.addCity("Multan", "Zone A");
-        int fsd = map.addCity("Faisalabad", "Zone A");
-        int qta = map.addCity("Quetta", "Zone D");
-        int rwp = map.addCity("Rawalpindi", "Zone B");
-        int suk = map.addCity("Sukkur", "Zone C");
-        int sgd = map.addCity("Sargodha", "Zone A");
-        int bwp = map.addCity("Bahawalpur", "Zone D");
-        int guj = map.addCity("Gujranwala", "Zone A");
-        int swl = map.addCity("Sahiwal", "Zone A");
-        int okk = map.addCity("Okara", "Zone B");
-        int mbd = map.addCity("Mandi Bahauddin", "Zone C");
-        int ryk = map.addCity("Rahim Yar Khan", "Zone D");
-        int hfd = map.addCity("Hafizabad", "Zone A");
-        int skt = map.addCity("Sialkot", "Zone A");
-        int ghr = map.addCity("Gujrat", "Zone A");
-        int veh = map.addCity("Vehari", "Zone D");
-        int goj = map.addCity("Gojra", "Zone A");
-        int mrd = map.addCity("Mardan", "Zone B");
-        int swb = map.addCity("Swabi", "Zone B");
-        int gwd = map.addCity("Gwadar", "Zone D");
-        int hyd = map.addCity("Hyderabad", "Zone C");
-        
-        map.addRoad(lhr, isb, 375, 20);
-        map.addRoad(lhr, fsd, 180, 18);
-        map.addRoad(lhr, mux, 345, 15);
-        map.addRoad(lhr, guj, 70, 15);
-        map.addRoad(lhr, swl, 175, 12);
-        map.addRoad(lhr, okk, 100, 10);        
-        map.addRoad(isb, pew, 155, 18);
-        map.addRoad(isb, rwp, 20, 25);       
-        map.addRoad(fsd, sgd, 85, 15);
-        map.addRoad(fsd, goj, 30, 10);
-        map.addRoad(fsd, mux, 240, 15);        
-        map.addRoad(mux, bwp, 90, 12);
-        map.addRoad(mux, veh, 70, 10);
-        map.addRoad(mux, suk, 490, 15);        
-        map.addRoad(suk, khi, 470, 18);
-        map.addRoad(suk, hyd, 320, 15);
-        map.addRoad(suk, qta, 390, 12);        
-        map.addRoad(khi, hyd, 165, 20);
-        map.addRoad(khi, gwd, 700, 10);        
-        map.addRoad(qta, gwd, 700, 10);        
-        map.addRoad(pew, mrd, 50, 15);
-        map.addRoad(pew, swb, 70, 12);        
-        map.addRoad(mrd, swb, 40, 12);        
-        map.addRoad(guj, skt, 50, 15);
-        map.addRoad(guj, ghr, 40, 15);
-        map.addRoad(guj, hfd, 50, 12);        
-        map.addRoad(skt, ghr, 60, 12);        
-        map.addRoad(sgd, mbd, 110, 12);        
-        map.addRoad(bwp, ryk, 80, 12);       
-        map.addRoad(swl, okk, 50, 12);
-        map.addRoad(swl, veh, 120, 10);      
-        map.addRoad(hfd, lhr, 105, 15);
-        map.addRoad(hfd, fsd, 90, 12);       
-        map.addRoad(veh, bwp, 140, 10);       
-        map.addRoad(hyd, gwd, 550, 10);
+        return errors;
     }
 
-    void displayAllCities() {
-        map.displayAllCities();
+    void execute(const string& line, int lineNo) 
+    {
+        string t[MAX_TOKENS];
+        int n = split(line, t);
+        if (n == 0 || t[0][0] == '#') 
+            return;
+        commands++;
+        const string& cmd = t[0];
+
+        if (cmd == "pickup" && n >= 5) 
+            engine.requestPickup(t[1], join(t, 2, n - 2), t[n - 2], t[n - 1]);
+        else if (cmd == "import" && n >= 2) 
+            engine.importManifest(join(t, 1, n));
+        else if (cmd == "dispatch") 
+        {
+            int count = 1;
+            if (n >= 2) 
+                count = (t[1] == "all") ? engine.queuedCount() : atoi(t[1].c_str());
+            for (int i = 0; i < count && engine.queuedCount() > 0; i++) 
+                engine.processNext();
+        }
+        else if (cmd == "route" && n >= 2) 
+        {
+            if (t[1] == "recommended") 
+                engine.setRouteSelection(ROUTE_RECOMMENDED);
+            else if (t[1] == "prompt") 
+                engine.setRouteSelection(ROUTE_PROMPT);
+            else 
+                engine.setRouteSelection(ROUTE_FIXED, atoi(t[1].c_str()));
+        }
+        else if (cmd == "cancel" && n >= 2) 
+            engine.cancelParcel(t[1]);
+        else if (cmd == "priority" && n >= 3) 
+            engine.changePriority(t[1], atoi(t[2].c_str()));
+        else if (cmd == "undo") 
+            engine.undoLast();
+        else if (cmd == "view" && n >= 2) 
+            engine.viewParcel(t[1]);
+        else if (cmd == "list") 
+            engine.listAll();
+        else if (cmd == "map") 
+            engine.showMap();
+        else if (cmd == "riders") 
+            engine.showRiderStatus();
+        else if (cmd == "summary") 
+            engine.showStatusSummary();
+        else if (cmd == "purge") 
+            engine.purgeFinished();
+        else if (cmd == "reroute") 
+            engine.forceRouteRecalculation();
+        else if (cmd == "tick") 
+            ;
+        else if (cmd == "clock" && n >= 2 && t[1] == "virtual") 
+            simClock.useVirtual();
+        else if (cmd == "clock" && n >= 2 && t[1] == "real") 
+            simClock.useReal();
+        else if (cmd == "seed" && n >= 2) 
+            engine.setSeed(strtoull(t[1].c_str(), nullptr, 10));
+        else if (cmd == "threads" && n >= 2) 
+            engine.setThreads(atoi(t[1].c_str()));
+        else if (cmd == "advance" && n >= 2) 
+            engine.fastForward(atoll(t[1].c_str()) * 1000);
+        else if (cmd == "persist" && n >= 2) 
+        {
+            if (!engine.enablePersistence(join(t, 1, n))) 
+                fail(lineNo, "cannot enable persistence");
+        }
+        else if (cmd == "snapshot") 
+            engine.snapshot();
+        else if (cmd == "query" && n >= 3) 
+        {
+            if (t[1] == "status") 
+                engine.queryByStatus(atoi(t[2].c_str()), join(t, 3, n));
+            else if (t[1] == "zone") 
+                engine.queryByZone(join(t, 2, n));
+            else if (t[1] == "dest") 
+                engine.queryByDestination(join(t, 2, n));
+            else if (t[1] == "rider") 
+                engine.queryByRider(join(t, 2, n));
+            else 
+                fail(lineNo, "unknown query '" + t[1] + "'");
+        }
+        else if (cmd == "echo") 
+            cout << join(t, 1, n) << "\n";
+        else if (cmd == "quiet") 
+            console.verbose = false;
+        else if (cmd == "verbose") 
+            console.verbose = true;
+        else 
+        {
+            fail(lineNo, "cannot parse '" + line + "'");
+            return;
+        }
+
+        engine.updateRealTime();
     }
-    
-    void requestPickup(string id, string dest, double w, int p) 
+
+    bool run(istream& in) 
     {
-        clearScreen();
-        if (map.getCityIndex(dest) == -1) 
-        { 
-            cout << "Error: Destination not valid.\n"; 
-            pauseFunc(); 
-            return; 
-        }
-        
-        if (database.search(id)) 
+        string line;
+        int lineNo = 0;
+        while (getline(in, line)) 
         {
-            cout << "Error: ID already exists.\n"; 
-            pauseFunc(); 
-            return; 
+            if (!line.empty() && line[line.size() - 1] == '\r') 
+                line.erase(line.size() - 1);
+            execute(line, ++lineNo);
         }
-        
-        string zone = map.getZone(dest);
-        Parcel* newP = new Parcel(id, dest, w, p, zone);
-        database.insert(id, newP); 
-        
-        newP->updateStatus(STATUS_WAREHOUSE, "Arrived at Warehouse", "Central Hub");
-        
-        sortingQueue.insert(newP); 
-        
-        undoStack.push("ADD", id);
-        cout << ">> Pickup Request Logged.\n";
-        cout << "   Category: " << newP->weightCategory << " | Zone: " << newP->zone << "\n";
-        cout << "   Status: Moved to Warehouse Queue.\n";
-        pauseFunc();
+        return errors == 0;
     }
+};
 
-    void processNext() 
+int runScript(const string& path, bool quiet) 
+{
+    console.clearScreen = false;
+    console.pause = false;
+    console.verbose = !quiet;
+
+    ifstream file;
+    if (path != "-") 
     {
-        clearScreen();
-        if(sortingQueue.isEmpty()) 
-        { 
-            cout << ">> Warehouse Queue Empty.\n"; 
-            pauseFunc(); 
-            return; 
+        file.open(path.c_str());
+        if (!file) 
+        {
+            cerr << "Cannot open script '" << path << "'\n";
+            return 1;
         }
+    }
 
-        Parcel* p = sortingQueue.extractMax(); 
-        string rider = riderManager.assignRider(p);
-        
-        if (rider.empty()) {
-            cout << ">> No Suitable Riders Available! Parcel returned to queue.\n";
-            sortingQueue.insert(p);
-            pauseFunc();
-            return;
-        }
-        
-        p->assignedRider = rider;
-        
-        int start = map.getCityIndex("Lahore");
-        int end = map.getCityIndex(p->destination);
+    LogisticsEngine engine;
+    engine.setRouteSelection(ROUTE_RECOMMENDED);
+    ScriptRunner runner(engine);
 
-        cout << ">> Calculating routes for " << p->id << " to " << p->destination << "...\n";
-        map.findAllPaths(start, end);
+    chrono::steady_clock::time_point started = chrono::steady_clock::now();
+    bool ok = runner.run(path == "-" ? cin : file);
+    double seconds = elapsedMicros(started) / 1000000.0;
 
-        if (map.pathCount == 0) 
+    cout << "\n>> Script finished: " << runner.commandCount() << " command(s), " 
+         << runner.errorCount() << " error(s) in " << fixed << setprecision(3) << seconds << "s";
+    if (seconds > 0) 
+        cout << " (" << (long long)(runner.commandCount() / seconds) << " ops/sec)";
+    cout << "\n";
+    return ok ? 0 : 2;
+}
+
+struct LegacyCity 
+{
+    string name;
+    string zone;
+    EdgeArrayList edges;
+};
+
+long long legacyDijkstra(LegacyCity* cities, int n, int src, int* dist) 
+{
+    for(int i=0; i<n; i++) 
+        dist[i] = INT_MAX;
+    dist[src] = 0;
+    DistanceHeap pq;
+    pq.push(0, src);
+    long long checksum = 0;
+    while (!pq.isEmpty()) 
+    {
+        int d, u;
+        pq.pop(d, u);
+        if (d > dist[u]) 
+            continue;
+        checksum += d;
+        EdgeArrayList& edges = cities[u].edges;
+        for(int i=0; i<edges.size(); i++) 
         {
-            cout << ">> ALERT: No paths available. Returning to Sender.\n";
-            p->updateStatus(STATUS_RETURNED, "No Route Available", "Warehouse");
-            riderManager.releaseRider(rider);
-            pauseFunc();
-            return;
+            Edge& e = edges.getRef(i);
+            if (e.blocked || e.isOverloaded()) 
+                continue;
+            if (d + e.weight < dist[e.dest]) 
+            {
+                dist[e.dest] = d + e.weight;
+                pq.push(dist[e.dest], e.dest);
+            }
         }
+    }
+    return checksum;
+}
 
-        int minIdx = map.getMinRouteIndex();
-        cout << "------------------------------------------------\n";
-        for(int i=0; i<map.pathCount; i++) 
+long long csrDijkstra(MapGraph& g, int src, int* dist) 
+{
+    for(int i=0; i<g.cityCount; i++) 
+        dist[i] = INT_MAX;
+    dist[src] = 0;
+    DistanceHeap pq;
+    pq.push(0, src);
+    long long checksum = 0;
+    while (!pq.isEmpty()) 
+    {
+        int d, u;
+        pq.pop(d, u);
+        if (d > dist[u]) 
+            continue;
+        checksum += d;
+        for(int e = g.edgeOffset[u]; e < g.edgeOffset[u + 1]; e++) 
         {
-            cout << "   [" << i << "] Distance: " << map.availablePathDistances[i] << " km ";
-            if(i == minIdx) cout << "(RECOMMENDED - SHORTEST)";
-            cout << "\n       Path: ";
-            IntArrayList& path = map.availablePaths[i];
-            for(int j=0; j<path.size(); j++) 
+            if (g.edgeState[e].blocked || g.isOverloaded(e)) 
+                continue;
+            int v = g.edgeDest[e];
+            if (d + g.edgeWeight[e] < dist[v]) 
             {
-                cout << map.cities[path.get(j)].name << (j < path.size()-1 ? " -> " : "");
+                dist[v] = d + g.edgeWeight[e];
+                pq.push(dist[v], v);
             }
-            cout << "\n";
         }
-        cout << "------------------------------------------------\n";
-        
-        int choice;
-        cout << ">> Select Route ID to Dispatch: ";
-        cin >> choice;
-        
-        if (choice < 0 || choice >= map.pathCount) 
+    }
+    return checksum;
+}
+
+void runGraphBenchmark() 
+{
+    const int sizes[] = {10000, 100000, 1000000};
+    cout << "\n=== GRAPH LAYOUT BENCHMARK (adjacency lists vs CSR) ===\n";
+    cout << left << setw(10) << "Edges" << setw(10) << "Cities" 
+         << setw(14) << "Scan(old)" << setw(14) << "Scan(CSR)" 
+         << setw(14) << "Dijk(old)" << setw(14) << "Dijk(CSR)" << "\n";
+
+    for(int s=0; s<3; s++) 
+    {
+        int edges = sizes[s];
+        int roads = edges / 2;
+        int n = edges / 8;
+
+        LegacyCity* legacy = new LegacyCity[n];
+        MapGraph csr(n);
+        for(int i=0; i<n; i++) 
         {
-            cout << "Invalid selection. Using Recommended Route.\n";
-            choice = minIdx;
+            legacy[i].name = "City" + to_string(i);
+            legacy[i].zone = "Zone A";
+            csr.addCity(legacy[i].name, legacy[i].zone);
         }
 
-        if (rand() % 10 < 3)
-        { 
-            if (rand() % 2 == 0) {
-                cout << "\n>>> [LIVE UPDATE] Road Blockage Detected on selected route!\n";
-                map.blockRandomRoad();
-            } else {
-                cout << "\n>>> [LIVE UPDATE] Road Overload Detected on selected route!\n";
-                map.checkOverloads();
-            }
-            
-            cout << ">>> Re-calculating Best Route automatically...\n";
-            map.findAllPaths(start, end); 
-            
-            if (map.pathCount > 0) 
-            {
-                choice = map.getMinRouteIndex(); 
-                cout << ">>> Rerouted to new optimal path.\n";
-            } 
-            else 
+        srand(42);
+        for(int i=0; i<roads; i++) 
+        {
+            int u = (i < n - 1) ? i : rand() % n;
+            int v = (i < n - 1) ? i + 1 : rand() % n;
+            int w = 1 + rand() % 500;
+            int maxLoad = 10 + rand() % 15;
+            legacy[u].edges.add(Edge(v, w, maxLoad));
+            legacy[v].edges.add(Edge(u, w, maxLoad));
+            csr.addRoad(u, v, w, maxLoad);
+        }
+        csr.freeze();
+
+        int reps = 20000000 / edges;
+        long long oldSum = 0, csrSum = 0;
+
+        chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+        for(int r=0; r<reps; r++) 
+            for(int i=0; i<n; i++) 
             {
-                 cout << ">>> Rerouting Failed. Returning to Sender.\n";
-                 p->updateStatus(STATUS_RETURNED, "Dynamic Route Issue - RTS", "Warehouse");
-                 riderManager.releaseRider(rider);
-                 pauseFunc();
-                 return;
+                EdgeArrayList& list = legacy[i].edges;
+                for(int k=0; k<list.size(); k++) 
+                    if (list.getRef(k).isOverloaded() && !list.getRef(k).blocked) 
+                        oldSum++;
+                    else 
+                        oldSum += list.getRef(k).currentLoad;
             }
-        }
+        long long oldScan = elapsedMicros(t0) / reps;
 
-        p->currentRoute = new IntArrayList(map.availablePaths[choice]);
-        p->currentRouteDistance = map.availablePathDistances[choice];
-        p->currentPosition = 0;
-        
-        map.updateEdgeLoad(map.availablePaths[choice], 1);
+        t0 = chrono::steady_clock::now();
+        for(int r=0; r<reps; r++) 
+            for(int i=0; i<n; i++) 
+                for(int e = csr.edgeOffset[i]; e < csr.edgeOffset[i + 1]; e++) 
+                    if (csr.isOverloaded(e) && !csr.edgeState[e].blocked) 
+                        csrSum++;
+                    else 
+                        csrSum += csr.edgeState[e].currentLoad;
+        long long csrScan = elapsedMicros(t0) / reps;
 
-        p->updateStatus(STATUS_LOADING, "Loading onto Truck", "Bay 4");
-        long long travelSecs = 10 + (rand() % 21);
-        p->dispatchTime = time(0);
-        p->arrivalTime = time(0) + travelSecs + 5; 
-        p->lastKnownTime = time(0);
-        
-        shippingList.pushBack(p);
-        undoStack.push("DISPATCH", p->id);
-        
-        cout << "\n>> PARCEL DISPATCHED SUCCESSFULLY.\n";
-        cout << "   Rider: " << rider << "\n   ETA: " << travelSecs << "s (transit) + 5s (loading)\n";
-        cout << "   Route Distance: " << p->currentRouteDistance << " km\n";
-        
-        pauseFunc();
-    }
+        int* dist = new int[n];
+        int dijkReps = (reps < 20) ? 1 : reps / 20;
+        t0 = chrono::steady_clock::now();
+        for(int r=0; r<dijkReps; r++) 
+            oldSum += legacyDijkstra(legacy, n, r % n, dist);
+        long long oldDijk = elapsedMicros(t0) / dijkReps;
 
-    void showMap() 
-    { 
-        map.displayNetwork(); 
-        pauseFunc(); 
+        t0 = chrono::steady_clock::now();
+        for(int r=0; r<dijkReps; r++) 
+            csrSum += csrDijkstra(csr, r % n, dist);
+        long long csrDijk = elapsedMicros(t0) / dijkReps;
+        delete[] dist;
+
+        cout << left << setw(10) << edges << setw(10) << n 
+             << setw(14) << (to_string(oldScan) + "us") << setw(14) << (to_string(csrScan) + "us") 
+             << setw(14) << (to_string(oldDijk) + "us") << setw(14) << (to_string(csrDijk) + "us");
+        if (oldSum != csrSum) 
+            cout << " (checksum mismatch!)";
+        cout << "\n";
+
+        delete[] legacy;
     }
-    
-    void showRiderStatus() {
-        riderManager.showRiderStatus();
-        pauseFunc();
+}
+
+void runQueueBenchmark() 
+{
+    const int N = 1000000;
+    ParcelStore store;
+    RouteTable routes;
+    ObjectPool<Parcel> pool;
+    Parcel** parcels = new Parcel*[N];
+    srand(42);
+    for (int i = 0; i < N; i++) 
+    {
+        parcels[i] = pool.create(store, routes);
+        parcels[i]->priority = 1 + rand() % 3;
+        parcels[i]->weight = rand() % 50;
+        parcels[i]->priorityScore = Parcel::scoreFor(parcels[i]->priority, parcels[i]->weight);
     }
 
-    void undoLast() 
+    cout << "\n=== WAREHOUSE QUEUE BENCHMARK (" << N << " parcels) ===\n";
+    cout << left << setw(14) << "Mode" << setw(14) << "Insert" << setw(14) << "Extract" 
+         << setw(10) << "Ordered" << "FIFO ties\n";
+
+    for (int m = 0; m < 2; m++) 
     {
-        clearScreen();
-        UndoAction act;
-        if(undoStack.pop(act)) 
+        ParcelHeap queue(m == 0 ? QUEUE_HEAP : QUEUE_BUCKET);
+
+        chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+        for (int i = 0; i < N; i++) 
+            queue.insert(parcels[i]);
+        long long insertUs = elapsedMicros(t0);
+
+        bool ordered = true, fifo = true;
+        Parcel* prev = nullptr;
+        t0 = chrono::steady_clock::now();
+        for (int i = 0; i < N; i++) 
         {
-            Parcel* p = database.search(act.parcelId);
-            if(p) 
+            Parcel* p = queue.extractMax();
+            if (prev) 
             {
-                if(act.type == "ADD") 
-                {
-                    p->updateStatus(STATUS_CANCELLED, "Undo: Creation Reverted", "N/A");
-                    cout << ">> Undo Add: Parcel " << p->id << " marked as cancelled.\n";
-                } 
-                else if (act.type == "DISPATCH") 
-                {
-                    p->updateStatus(STATUS_WAREHOUSE, "Undo: Dispatch Reverted", "Warehouse");
-                    p->arrivalTime = 0; 
-                    
-                    if (!p->assignedRider.empty()) {
-                        riderManager.releaseRider(p->assignedRider);
-                    }
-                    if (p->currentRoute) {
-                        map.updateEdgeLoad(*p->currentRoute, -1);
-                    }
-                    
-                    sortingQueue.insert(p); 
-                    cout << ">> Undo Dispatch: Parcel " << p->id << " returned to warehouse.\n";
-                }
+                if (p->priorityScore > prev->priorityScore) 
+                    ordered = false;
+                else if (p->priorityScore == prev->priorityScore && p->slot < prev->slot) 
+                    fifo = false;
             }
-        } 
-        else 
-        { 
-            cout << ">> Nothing to undo.\n"; 
+            prev = p;
         }
-        
-        pauseFunc();
+        long long extractUs = elapsedMicros(t0);
+
+        cout << left << setw(14) << (m == 0 ? "4-ary heap" : "bucket queue") 
+             << setw(14) << (to_string(insertUs / 1000) + "ms") 
+             << setw(14) << (to_string(extractUs / 1000) + "ms") 
+             << setw(10) << (ordered ? "yes" : "NO") << (fifo ? "yes" : "no") << "\n";
     }
+    for (int i = 0; i < N; i++) 
+        pool.destroy(parcels[i]);
+    delete[] parcels;
+}
 
-    void updateRealTime() 
+// Runs TICKS lifecycle steps over a synthetic fleet of in-transit parcels
+// and returns a digest of the final state.
+unsigned long long runTickFleet(const MapGraph& map, int fleetSize, int threads, long long& micros) 
+{
+    const int TICKS = 120;
+    simClock.useVirtual();
+    const long long start = nowMs();
+    simSeed = mix64(42);
+
+    ParcelStore store;
+    RouteTable routes;
+    Parcel** fleet = new Parcel*[fleetSize];
+    for (int i = 0; i < fleetSize; i++) 
     {
-        long long now = time(0);
-        
-        if (now % 10 == 0) {
-            map.checkOverloads();
-        }
-        
-        shippingList.recalculateRoutes(&map);
-        
-        shippingList.updateLifecycle(now, &map);
+        Parcel* p = new Parcel(store, routes, "T" + to_string(i), i % map.cityCount, 1 + i % 40, 1 + i % 3, 0);
+        p->setStatus(STATUS_IN_TRANSIT);
+        Route route;
+        for (int k = 0; k < 6; k++) 
+            route.add((i + k * 7) % map.cityCount);
+        p->setRoute(route, 0);
+        p->lastKnownTime() = start;
+        p->nextHopTime() = start + 1 + i % HOP_INTERVAL_MS;
+        p->arrivalTime() = start + 10000 + (i * 7919LL) % 60000;
+        fleet[i] = p;
     }
-    
-    void liveMonitor() 
+
+    LifecycleStepper stepper;
+    stepper.setThreads(threads);
+    IntArrayList due;
+    micros = 0;
+    for (int tick = 1; tick <= TICKS; tick++) 
     {
-        char cmd = 'r';
-        while (cmd == 'r' || cmd == 'R') 
-        {
-            clearScreen();
-            long long now = time(0);
-            updateRealTime();
-            shippingList.showTransitStatus(now);
-            cout << "\n[r] Refresh View   [x] Exit to Menu\nSelect: ";
-            cin >> cmd;
-        }
+        long long now = start + tick * 1000LL;
+        simClock.advanceTo(now);
+        due.clear();
+        for (int i = 0; i < fleetSize; i++) 
+            if (fleet[i]->status() >= STATUS_LOADING && fleet[i]->status() <= STATUS_DELIVERY_ATTEMPT) 
+                due.add(fleet[i]->slot);
+        chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+        stepper.step(store, due, now, map);
+        micros += elapsedMicros(t0);
     }
 
-    void viewParcel(string id) 
+    unsigned long long digest = 0;
+    for (int i = 0; i < fleetSize; i++) 
     {
-        clearScreen();
-        Parcel* p = database.search(id);
-        if(p) 
+        Parcel* p = fleet[i];
+        digest = mix64(digest ^ (unsigned long long)p->status());
+        digest = mix64(digest ^ (unsigned long long)p->currentPosition());
+        digest = mix64(digest ^ (unsigned long long)p->deliveryAttempts());
+        digest = mix64(digest ^ (unsigned long long)(p->lastKnownTime() - start));
+        digest = mix64(digest ^ (unsigned long long)(p->arrivalTime() - start));
+        delete p;
+    }
+    delete[] fleet;
+    return digest;
+}
+
+void runTickBenchmark() 
+{
+    const int N = 200000;
+    MapGraph map;
+    for (int i = 0; i < 25; i++) 
+        map.addCity("City" + to_string(i), "Zone A");
+    map.freeze();
+
+    bool wasVerbose = console.verbose;
+    console.verbose = false;
+
+    int cores = max(1, (int)thread::hardware_concurrency());
+    int counts[] = {1, 2, max(4, cores)};
+    long long baseUs = 0;
+    unsigned long long baseDigest = 0;
+
+    cout << "\n=== LIFECYCLE TICK BENCHMARK (" << N << " parcels, 120 ticks) ===\n";
+    cout << left << setw(10) << "Threads" << setw(14) << "Time" << setw(10) << "Speedup" << "Identical\n";
+    for (int c = 0; c < 3; c++) 
+    {
+        long long us;
+        unsigned long long digest = runTickFleet(map, N, counts[c], us);
+        if (c == 0) 
         {
-            cout << "\n==============================\n    PARCEL TRACKING DETAILS   \n==============================\n";
-            cout << *p << endl;
-            cout << "Assigned Rider: " << (p->assignedRider.empty() ? "Not Assigned" : p->assignedRider) << endl;
-            if (p->currentRoute) {
-                cout << "Route Distance: " << p->currentRouteDistance << " km\n";
-                cout << "Current Position: " << p->currentPosition << "/" << p->currentRoute->size() << endl;     
-            }
-            p->history->printTimeline();
-            
-            if (p->status == STATUS_IN_TRANSIT || p->status == STATUS_LOADING) 
-            {
-                long long now = time(0);
-                long long rem = p->arrivalTime - now;
-                if(rem > 0) cout << "\n>>> EST. DELIVERY IN: " << rem << " seconds\n";
-            }
-        } 
-        else 
-        { 
-            cout << "Parcel Not Found.\n"; 
+            baseUs = us;
+            baseDigest = digest;
         }
-        
-        pauseFunc();
+        cout << left << setw(10) << counts[c] 
+             << setw(14) << (to_string(us / 1000) + "ms") 
+             << setw(10) << (to_string(baseUs * 100 / max(us, 1LL) / 100.0).substr(0, 4) + "x") 
+             << (digest == baseDigest ? "yes" : "NO") << "\n";
     }
+    console.verbose = wasVerbose;
+}
 
-    void listAll() 
-    { 
-        database.printAll(); 
-        pauseFunc(); 
+// Scans 10M synthetic slots with the vector kernels and checks them
+// against a plain loop over the same columns.
+void runScanBenchmark() 
+{
+    const int N = 10000000;
+    const int ZONES = 4;
+    const int REPEAT = 5;
+    unsigned char* status = new unsigned char[N];
+    unsigned char* zone = new unsigned char[N];
+    long long* lastUpdate = new long long[N];
+    long long* lastKnown = new long long[N];
+    long long* arrival = new long long[N];
+    int* selected = new int[N];
+    const long long now = 1700000000000LL;
+
+    unsigned long long x = 7;
+    for (int i = 0; i < N; i++) 
+    {
+        x = mix64(x + i);
+        int r = (int)(x % 100);
+        status[i] = (unsigned char)(r < 70 ? STATUS_IN_TRANSIT : r < 80 ? STATUS_LOADING : r < 98 ? r % STATUS_COUNT : ParcelStore::SLOT_FREE);
+        zone[i] = (unsigned char)((x >> 8) % ZONES);
+        lastUpdate[i] = now - (long long)((x >> 16) % 6000);
+        lastKnown[i] = now - (long long)((x >> 24) % 16000);
+        arrival[i] = now - 30000 + (long long)((x >> 32) % 600000);
     }
-    
-    void cancelParcel(string id) 
+
+    struct Filter 
     {
-        clearScreen();
-        Parcel* p = database.search(id);
-        if(p && p->status <= STATUS_WAREHOUSE) 
+        const char* name;
+        const long long* time;
+        int status;
+        long long limit;
+    };
+    Filter filters[] = 
+    {
+        {"departures", lastUpdate, STATUS_LOADING, now - LOADING_MS},
+        {"arrivals", arrival, STATUS_IN_TRANSIT, now},
+        {"signal timeouts", lastKnown, STATUS_IN_TRANSIT, now - SIGNAL_TIMEOUT_MS - 1}
+    };
+
+#if defined(SWIFTEX_AVX2)
+    const char* kernel = "AVX2";
+#elif defined(SWIFTEX_SSE2)
+    const char* kernel = "SSE2";
+#else
+    const char* kernel = "scalar";
+#endif
+    cout << "\n=== COLUMN SCAN BENCHMARK (" << N << " slots, " << kernel << " kernels, best of " << REPEAT << ") ===\n";
+    cout << left << setw(22) << "Scan" << setw(12) << "Matches" << setw(12) << "Vector" << setw(12) << "Scalar" << "Same\n";
+
+    for (int f = 0; f < 3; f++) 
+    {
+        long long best = LLONG_MAX;
+        int found = 0;
+        for (int r = 0; r < REPEAT; r++) 
         {
-            p->updateStatus(STATUS_CANCELLED, "Cancelled by User", "Warehouse");
-            cout << ">> Parcel " << id << " cancelled.\n";
-        } 
-        else if (p && p->status == STATUS_IN_TRANSIT) {
-            cout << ">> Parcel is in transit. Attempting to reroute back...\n";
-            p->updateStatus(STATUS_RETURNED, "Cancelled During Transit - Returning", "In Transit");
-            if (p->currentRoute) {
-                map.updateEdgeLoad(*p->currentRoute, -1);
+            chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+            found = selectDue(status, filters[f].time, N, filters[f].status, filters[f].limit, selected);
+            best = min(best, elapsedMicros(t0));
+        }
+
+        chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+        int expected = 0;
+        bool same = true;
+        for (int i = 0; i < N; i++) 
+        {
+            if (status[i] == filters[f].status && filters[f].time[i] <= filters[f].limit) 
+            {
+                if (expected >= found || selected[expected] != i) 
+                    same = false;
+                expected++;
             }
         }
-        else 
-            cout << ">> Error: Cannot cancel (Already Delivered or Missing).\n";
-        
-        pauseFunc();
+        long long scalarUs = elapsedMicros(t0);
+        same = same && expected == found;
+
+        cout << left << setw(22) << filters[f].name << setw(12) << found 
+             << setw(12) << (to_string(best / 1000.0).substr(0, 5) + "ms") 
+             << setw(12) << (to_string(scalarUs / 1000.0).substr(0, 5) + "ms") 
+             << (same ? "yes" : "NO") << "\n";
     }
-    
-    void forceRouteRecalculation() {
-        clearScreen();
-        cout << ">>> Forcing route recalculation for all parcels in transit...\n";
-        shippingList.recalculateRoutes(&map);
-        cout << ">>> Route recalculation complete.\n";
-        pauseFunc();
+
+    int counts[STATUS_COUNT * ZONES];
+    long long best = LLONG_MAX;
+    for (int r = 0; r < REPEAT; r++) 
+    {
+        chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+        countByStatusZone(status, zone, N, ZONES, counts);
+        best = min(best, elapsedMicros(t0));
     }
-};
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    int expected[STATUS_COUNT * ZONES] = {0};
+    for (int i = 0; i < N; i++) 
+        if (status[i] < STATUS_COUNT) 
+            expected[status[i] * ZONES + zone[i]]++;
+    long long scalarUs = elapsedMicros(t0);
+    bool same = true;
+    for (int k = 0; k < STATUS_COUNT * ZONES; k++) 
+        if (counts[k] != expected[k]) 
+            same = false;
+    cout << left << setw(22) << "status x zone counts" << setw(12) << (STATUS_COUNT * ZONES) 
+         << setw(12) << (to_string(best / 1000.0).substr(0, 5) + "ms") 
+         << setw(12) << (to_string(scalarUs / 1000.0).substr(0, 5) + "ms") 
+         << (same ? "yes" : "NO") << "\n";
+
+    delete[] status;
+    delete[] zone;
+    delete[] lastUpdate;
+    delete[] lastKnown;
+    delete[] arrival;
+    delete[] selected;
+}
 
-int main() 
+int main(int argc, char* argv[]) 
 {
+    if (argc > 1 && string(argv[1]) == "--bench-graph") 
+    {
+        runGraphBenchmark();
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--bench-queue") 
+    {
+        runQueueBenchmark();
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--bench-tick") 
+    {
+        runTickBenchmark();
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--bench-scan") 
+    {
+        runScanBenchmark();
+        return 0;
+    }
+    if (argc > 2 && string(argv[1]) == "--script") 
+    {
+        bool quiet = (argc > 3 && string(argv[3]) == "--quiet");
+        return runScript(argv[2], quiet);
+    }
+
     LogisticsEngine engine;
+    if (argc > 2 && string(argv[1]) == "--data") 
+    {
+        if (!engine.enablePersistence(argv[2])) 
+            return 1;
+        pauseFunc();
+    }
     int mainChoice;
     
     while (true) 
@@ -1524,17 +7192,20 @@ int main()
             case 1: 
             {
                 int sub = 0;
-                while (sub != 4) {
+                while (sub != 7) {
                     clearScreen();
                     cout << "\n---  INTELLIGENT PARCEL SORTING MODULE ---\n";
                     cout << "1. New Pickup Request\n";
                     cout << "2. Cancel/Withdraw Parcel\n";
                     cout << "3. View Sorting Database\n";
-                    cout << "4. Return to Main Menu\n";
+                    cout << "4. Purge Finished Parcels\n";
+                    cout << "5. Change Parcel Priority\n";
+                    cout << "6. Bulk Import Manifest (CSV/TSV)\n";
+                    cout << "7. Return to Main Menu\n";
                     cout << "Enter choice: ";
                     cin >> sub;
                     if(sub == 1) {
-                        string id, dest; double w; int p;
+                        string id, dest, w, p;
                         cout << "ID: "; cin >> id; cin.ignore(1000, '\n');
                         engine.displayAllCities();
                         cout << "Destination: "; getline(cin, dest);
@@ -1552,6 +7223,21 @@ int main()
                     else if(sub == 3) { 
                         engine.listAll(); 
                     }
+                    else if(sub == 4) { 
+                        engine.purgeFinished(); 
+                    }
+                    else if(sub == 5) { 
+                        string id; int p;
+                        cout << "ID: "; cin >> id;
+                        cout << "New Priority (1=Normal, 2=Express, 3=Overnight): "; cin >> p;
+                        engine.changePriority(id, p); 
+                    }
+                    else if(sub == 6) { 
+                        string path;
+                        cout << "Manifest file (id,destination,weight,priority): "; 
+                        cin.ignore(1000, '\n'); getline(cin, path);
+                        engine.importManifest(path); 
+                    }
                     engine.updateRealTime();
                 }
                 break;
@@ -1576,12 +7262,13 @@ int main()
             case 3:
             {
                 int sub = 0;
-                while (sub != 3) {
+                while (sub != 4) {
                     clearScreen();
                     cout << "\n--- PARCEL TRACKING SYSTEM ---\n";
                     cout << "1. Track Specific Parcel\n";
                     cout << "2. Live Transit Monitor\n";
-                    cout << "3. Return to Main Menu\n";
+                    cout << "3. Dashboard Queries\n";
+                    cout << "4. Return to Main Menu\n";
                     cout << "Ente choice: ";
                     cin >> sub;
                     if(sub == 1) { 
@@ -1591,6 +7278,38 @@ int main()
                         engine.viewParcel(id); 
                     }
                     else if(sub == 2) engine.liveMonitor();
+                    else if(sub == 3) {
+                        int q;
+                        engine.showStatusSummary();
+                        cout << "\n1. By Status (optionally within a Zone)\n";
+                        cout << "2. By Zone\n";
+                        cout << "3. By Destination City\n";
+                        cout << "4. By Rider\n";
+                        cout << "Enter choice: ";
+                        cin >> q;
+                        cin.ignore(1000, '\n');
+                        if(q == 1) {
+                            int status; string zone;
+                            cout << "Status number: "; cin >> status; cin.ignore(1000, '\n');
+                            cout << "Zone (blank for all): "; getline(cin, zone);
+                            if(status >= 0 && status < STATUS_COUNT) engine.queryByStatus(status, zone);
+                        }
+                        else if(q == 2) {
+                            string zone;
+                            cout << "Zone (e.g. Zone C): "; getline(cin, zone);
+                            engine.queryByZone(zone);
+                        }
+                        else if(q == 3) {
+                            string city;
+                            cout << "City: "; getline(cin, city);
+                            engine.queryByDestination(city);
+                        }
+                        else if(q == 4) {
+                            string name;
+                            cout << "Rider name: "; getline(cin, name);
+                            engine.queryByRider(name);
+                        }
+                    }
                     engine.updateRealTime();
                 }
                 break;
@@ -1598,18 +7317,26 @@ int main()
             case 4:
             {
                 int sub = 0;
-                while (sub != 4) {
+                while (sub != 5) {
                     clearScreen();
                     cout << "\n--- COURIER OPERATIONS ENGINE ---\n";
                     cout << "1. Warehouse Dispatch (Process Next)\n";
                     cout << "2. View Rider Status\n";
                     cout << "3. Undo Last Operation\n";
-                    cout << "4. Return to Main Menu\n";
+                    cout << "4. Fast-Forward Simulation\n";
+                    cout << "5. Return to Main Menu\n";
                     cout << "Enter choice: ";
                     cin >> sub;
                     if(sub == 1) engine.processNext();
                     else if(sub == 2) engine.showRiderStatus();
                     else if(sub == 3) engine.undoLast();
+                    else if(sub == 4) {
+                        long long secs;
+                        cout << "Simulated seconds to skip: ";
+                        cin >> secs;
+                        if (secs > 0) engine.fastForward(secs * 1000);
+                        pauseFunc();
+                    }
                     engine.updateRealTime();
                 }
                 break;